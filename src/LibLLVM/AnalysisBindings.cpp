@@ -1,13 +1,201 @@
 #include "AnalysisBindings.h"
 #include "llvm-c/Analysis.h"
 #include "llvm-c/Initialization.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/IR/Module.h"
+#include "llvm/IR/ModuleSlotTracker.h"
+#include "llvm/IR/TypeFinder.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
 
 using namespace llvm;
 
+namespace
+{
+    struct VerifierDiagnostics
+    {
+        std::vector<LLVMVerifierDiagnostic> Records;
+        std::string Text;
+    };
+
+    // The verifier reports each failed check as a line with the description of the check
+    // followed by lines for the values involved. Descriptions are free form text, so value
+    // lines are recognized instead: printed instructions are indented, and other values
+    // start with their type, a metadata ('!'), global ('@'), local ('%') or comdat ('$')
+    // reference, or a '<' (vector type or "<badref>"). Every other line starts a new check.
+    bool StartsWithKeyword( StringRef line, StringRef keyword )
+    {
+        return line.startswith( keyword )
+            && ( line.size( ) == keyword.size( ) || !std::isalnum( static_cast< unsigned char >( line[ keyword.size( ) ] ) ) );
+    }
+
+    bool IsDigit( char c )
+    {
+        return std::isdigit( static_cast< unsigned char >( c ) ) != 0;
+    }
+
+    bool StartsWithType( StringRef line )
+    {
+        // integer types are 'i' followed by the bit width
+        if( line.size( ) > 1 && line.front( ) == 'i' && IsDigit( line[ 1 ] ) )
+            return StartsWithKeyword( line, line.take_while( [ ]( char c ) { return c == 'i' || IsDigit( c ); } ) );
+
+        static char const* const keywords[ ] =
+        {
+            "void", "half", "float", "double", "x86_fp80", "fp128", "ppc_fp128",
+            "x86_mmx", "label", "metadata", "token", "define", "declare"
+        };
+
+        return std::any_of( std::begin( keywords ), std::end( keywords ), [ & ]( char const* keyword )
+        {
+            return StartsWithKeyword( line, keyword );
+        } );
+    }
+
+    bool IsCheckDescription( StringRef line )
+    {
+        if( line.empty( ) || line.front( ) == ' ' )
+            return false;
+
+        // '{' and '[' start struct and array types
+        if( StringRef( "!@%$<{[" ).find( line.front( ) ) != StringRef::npos )
+            return false;
+
+        return !StartsWithType( line );
+    }
+
+    // Stream that keeps the output of at most maxChecks failed checks and drops the rest,
+    // so a badly broken function doesn't produce an unbounded amount of text.
+    class BoundedCheckStream
+        : public raw_ostream
+    {
+    public:
+        BoundedCheckStream( unsigned maxChecks )
+            : raw_ostream( true )
+            , MaxChecks( maxChecks )
+        {
+        }
+
+        // the stream must be flushed before getting the text
+        std::string const& GetText( )
+        {
+            if( !Line.empty( ) && !IsFull )
+                AppendLine( );
+
+            return Text;
+        }
+
+    private:
+        void write_impl( char const* ptr, size_t size ) override
+        {
+            Position += size;
+            for( char const* end = ptr + size; ptr != end && !IsFull; ++ptr )
+            {
+                // whether a line is a check description is only known once the line is complete
+                Line += *ptr;
+                if( *ptr == '\n' )
+                    AppendLine( );
+            }
+        }
+
+        void AppendLine( )
+        {
+            if( IsCheckDescription( Line ) && MaxChecks != 0 && ++CheckCount > MaxChecks )
+                IsFull = true;
+            else
+                Text += Line;
+
+            Line.clear( );
+        }
+
+        uint64_t current_pos( ) const override { return Position; }
+
+        std::string Text;
+        std::string Line;
+        unsigned MaxChecks;
+        unsigned CheckCount = 0;
+        uint64_t Position = 0;
+        bool IsFull = false;
+    };
+
+    // one failed check in a broken function
+    struct CheckFailure
+    {
+        unsigned InstructionIndex;
+        std::string Text;
+    };
+
+    struct FunctionFailure
+    {
+        unsigned FunctionIndex;
+        std::vector<CheckFailure> Checks;
+    };
+
+    // Splits the verifier output for a function into the failed checks and attributes each to
+    // the first instruction of the function printed in it, if any. Instructions that print
+    // the same as another instruction of the function can't be told apart, so a check is
+    // only attributed to an instruction with a unique printed form.
+    std::vector<CheckFailure> SplitChecks( Function const& F, StringRef text )
+    {
+        SmallVector<StringRef, 16> lines;
+        text.split( lines, '\n', -1, false );
+
+        // the verifier prints instructions the same way as Instruction::print, so they
+        // are matched on the exact text of the line
+        StringMap<unsigned> instructionLines;
+        bool hasIndentedLine = std::any_of( lines.begin( ), lines.end( ), [ ]( StringRef line ) { return line.startswith( " " ); } );
+        if( hasIndentedLine )
+        {
+            ModuleSlotTracker slotTracker( F.getParent( ) );
+            unsigned index = 0;
+            for( BasicBlock const& block : F )
+            {
+                for( Instruction const& I : block )
+                {
+                    std::string printed;
+                    raw_string_ostream stream( printed );
+                    I.print( stream, slotTracker );
+                    auto inserted = instructionLines.insert( std::make_pair( stream.str( ), index++ ) );
+                    if( !inserted.second )
+                        inserted.first->second = LLVMVerifierNoInstruction;
+                }
+            }
+        }
+
+        std::vector<CheckFailure> checks;
+        for( StringRef line : lines )
+        {
+            if( checks.empty( ) || IsCheckDescription( line ) )
+                checks.push_back( CheckFailure{ LLVMVerifierNoInstruction, std::string( ) } );
+
+            CheckFailure& check = checks.back( );
+            if( check.InstructionIndex == LLVMVerifierNoInstruction )
+            {
+                auto instruction = instructionLines.find( line );
+                if( instruction != instructionLines.end( ) )
+                    check.InstructionIndex = instruction->second;
+            }
+
+            check.Text += line;
+            check.Text += '\n';
+        }
+
+        return checks;
+    }
+}
+
+DEFINE_SIMPLE_CONVERSION_FUNCTIONS( VerifierDiagnostics, LLVMVerifierDiagnosticsRef )
+
 extern "C"
 {
     // The standard LLVMVerifyFunction (unlike LLVMVerifyModule) doesn't provide
@@ -37,5 +225,127 @@ extern "C"
 
         return Result;
     }
+
+    LLVMBool LLVMVerifyModuleFunctionsParallel( LLVMModuleRef M
+                                              , unsigned workerCount
+                                              , unsigned maxErrors
+                                              , LLVMVerifierDiagnosticsRef* outDiagnostics
+                                              )
+    {
+        Module const& module = *unwrap( M );
+        std::vector<Function const*> functions;
+        for( Function const& F : module )
+            functions.push_back( &F );
+
+        // The verifier checks whether struct types are sized, which caches the answer in the
+        // type the first time. That is shared by all functions, so it is done up front instead
+        // of racing in the workers.
+        TypeFinder structTypes;
+        structTypes.run( module, false );
+        for( StructType* structType : structTypes )
+            structType->isSized( );
+
+        // Printing the values of a failed check creates attribute sets and slot numbers in the
+        // context, so the workers only find the broken functions, without any output. Each
+        // worker claims the next function to verify, so long functions don't hold up a fixed
+        // partition. No more functions are claimed once maxErrors functions are broken, but a
+        // claimed function is always verified, thus the verified functions are always a prefix
+        // of the module holding at least the first maxErrors failed checks.
+        workerCount = std::max( 1u, std::min<unsigned>( workerCount, static_cast< unsigned >( functions.size( ) ) ) );
+        std::vector<std::vector<unsigned>> workerBrokenFunctions( workerCount );
+        std::atomic<unsigned> nextFunction( 0 );
+        std::atomic<unsigned> brokenFunctionCount( 0 );
+        {
+            ThreadPool pool( workerCount );
+            for( unsigned worker = 0; worker < workerCount; ++worker )
+            {
+                pool.async( [ & ]( unsigned workerIndex )
+                {
+                    while( maxErrors == 0 || brokenFunctionCount < maxErrors )
+                    {
+                        unsigned i = nextFunction++;
+                        if( i >= functions.size( ) )
+                            break;
+
+                        if( !functions[ i ]->isMaterializable( ) && verifyFunction( *functions[ i ], nullptr ) )
+                        {
+                            ++brokenFunctionCount;
+                            workerBrokenFunctions[ workerIndex ].push_back( i );
+                        }
+                    }
+                }, worker );
+            }
+
+            pool.wait( );
+        }
+
+        std::vector<unsigned> brokenFunctions;
+        for( auto& worker : workerBrokenFunctions )
+            brokenFunctions.insert( brokenFunctions.end( ), worker.begin( ), worker.end( ) );
+
+        std::sort( brokenFunctions.begin( ), brokenFunctions.end( ) );
+
+        // the broken functions are verified again, serially, to get the text of the failed checks
+        std::vector<FunctionFailure> failures;
+        unsigned failedChecks = 0;
+        for( unsigned i : brokenFunctions )
+        {
+            if( maxErrors != 0 && failedChecks >= maxErrors )
+                break;
+
+            BoundedCheckStream stream( maxErrors );
+            verifyFunction( *functions[ i ], &stream );
+            stream.flush( );
+            auto checks = SplitChecks( *functions[ i ], stream.GetText( ) );
+            failedChecks += static_cast< unsigned >( checks.size( ) );
+            failures.push_back( FunctionFailure{ i, std::move( checks ) } );
+        }
+
+        // the message id is based on the first line of a check, which describes the check
+        auto diagnostics = std::make_unique<VerifierDiagnostics>( );
+        StringMap<unsigned> messageIds;
+        for( auto const& failure : failures )
+        {
+            for( auto const& check : failure.Checks )
+            {
+                if( maxErrors != 0 && diagnostics->Records.size( ) == maxErrors )
+                    break;
+
+                StringRef description = StringRef( check.Text ).split( '\n' ).first;
+                unsigned messageId = messageIds.insert( std::make_pair( description, static_cast< unsigned >( messageIds.size( ) ) ) ).first->second;
+                diagnostics->Records.push_back( LLVMVerifierDiagnostic{ failure.FunctionIndex
+                                                                      , check.InstructionIndex
+                                                                      , messageId
+                                                                      , diagnostics->Text.size( )
+                                                                      , check.Text.size( )
+                                                                      } );
+                diagnostics->Text += check.Text;
+            }
+        }
+
+        *outDiagnostics = wrap( diagnostics.release( ) );
+        return !brokenFunctions.empty( );
+    }
+
+    unsigned LLVMVerifierDiagnosticsGetCount( LLVMVerifierDiagnosticsRef diagnostics )
+    {
+        return static_cast< unsigned >( unwrap( diagnostics )->Records.size( ) );
+    }
+
+    LLVMVerifierDiagnostic const* LLVMVerifierDiagnosticsGetRecords( LLVMVerifierDiagnosticsRef diagnostics )
+    {
+        return unwrap( diagnostics )->Records.data( );
+    }
+
+    char const* LLVMVerifierDiagnosticsGetText( LLVMVerifierDiagnosticsRef diagnostics, size_t* length )
+    {
+        *length = unwrap( diagnostics )->Text.size( );
+        return unwrap( diagnostics )->Text.data( );
+    }
+
+    void LLVMDisposeVerifierDiagnostics( LLVMVerifierDiagnosticsRef diagnostics )
+    {
+        delete unwrap( diagnostics );
+    }
 }
 
@@ -12,6 +12,48 @@ extern "C" {
                                    , LLVMVerifierFailureAction Action
                                    , char **OutMessages
                                    );
+
+    // Diagnostics of a module verification. All of the text for the diagnostics is held in a
+    // single buffer owned by the diagnostics, each record refers to its text by offset and length.
+    typedef struct LLVMOpaqueVerifierDiagnostics* LLVMVerifierDiagnosticsRef;
+
+    // InstructionIndex value of checks that don't involve an instruction of the function
+    #define LLVMVerifierNoInstruction (~0u)
+
+    typedef struct LLVMVerifierDiagnostic
+    {
+        unsigned FunctionIndex;     // index of the function in the module's function list
+        unsigned InstructionIndex;  // index of the instruction in the function (in block order) or LLVMVerifierNoInstruction
+        unsigned MessageId;         // identifies the check that failed, equal for equal checks within a result
+        size_t TextOffset;          // offset of the message in the diagnostics text (UTF-8, not terminated)
+        size_t TextLength;
+    } LLVMVerifierDiagnostic;
+
+    // Verifies the functions of a module concurrently on up to workerCount threads. The
+    // threads only find the broken functions, those are then verified again serially to
+    // produce the diagnostics, as printing the values involved updates the context. Thus,
+    // the module and its context must not be used by any other thread for the duration of
+    // the call. Functions not yet materialized are skipped. There is one record per failed
+    // check, in function order, regardless of thread scheduling. If maxErrors is not 0,
+    // verification stops once that many checks have failed and only the first maxErrors
+    // (in function order) are reported.
+    // Returns true if any function is broken. The caller owns the diagnostics and must release
+    // them with LLVMDisposeVerifierDiagnostics()
+    LLVMBool LLVMVerifyModuleFunctionsParallel( LLVMModuleRef M
+                                              , unsigned workerCount
+                                              , unsigned maxErrors
+                                              , LLVMVerifierDiagnosticsRef* outDiagnostics
+                                              );
+
+    unsigned LLVMVerifierDiagnosticsGetCount( LLVMVerifierDiagnosticsRef diagnostics );
+
+    // Gets the records of the diagnostics, the array remains valid until the diagnostics are disposed.
+    LLVMVerifierDiagnostic const* LLVMVerifierDiagnosticsGetRecords( LLVMVerifierDiagnosticsRef diagnostics );
+
+    // Gets the text buffer referenced by the records, which remains valid until the diagnostics are disposed.
+    char const* LLVMVerifierDiagnosticsGetText( LLVMVerifierDiagnosticsRef diagnostics, size_t* length );
+
+    void LLVMDisposeVerifierDiagnostics( LLVMVerifierDiagnosticsRef diagnostics );
 #ifdef __cplusplus
 }
 #endif
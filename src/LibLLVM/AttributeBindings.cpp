@@ -5,15 +5,18 @@
 #include "llvm\IR\Function.h"
 #include "llvm\IR\CallSite.h"
 #include "llvm\Support\CBindingWrapping.h"
+#include "StringResults.h"
 #include <type_traits>
 
 using namespace llvm;
 
 extern "C"
 {
-    char const* LLVMAttributeToString( LLVMAttributeRef attribute )
+    char const* LLVMAttributeToString( LLVMAttributeRef attribute, size_t* length )
     {
-        return LLVMCreateMessage( unwrap( attribute ).getAsString( ).c_str( ) );
+        std::string& buffer = GetThreadStringBuffer( );
+        buffer = unwrap( attribute ).getAsString( );
+        return BorrowString( buffer, length );
     }
 
 }
@@ -23,7 +23,10 @@
 extern "C" {
 #endif
 
-    char const* LLVMAttributeToString( LLVMAttributeRef attribute );
+    // returns a pointer and length (not terminated) for a string in a per thread buffer, it must
+    // not be disposed and remains valid until the next call returning a computed string on the
+    // same thread.
+    char const* LLVMAttributeToString( LLVMAttributeRef attribute, size_t* length );
 
 #ifdef __cplusplus
 }
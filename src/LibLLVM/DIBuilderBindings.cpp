@@ -14,10 +14,12 @@
 #include "DIBuilderBindings.h"
 
 #include "IRBindings.h"
+#include "StringResults.h"
 #include "llvm/IR/DIBuilder.h"
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Constant.h"
+#include "llvm/IR/TrackingMDRef.h"
 #include "llvm/Support/raw_ostream.h"
 
 using namespace llvm;
@@ -63,16 +65,16 @@ extern "C"
         return wrap( loc->getInlinedAtScope( ) );
     }
 
-    char const* LLVMGetDIFileName( LLVMMetadataRef /*DIFile*/ file )
+    char const* LLVMGetDIFileName( LLVMMetadataRef /*DIFile*/ file, size_t* length )
     {
         DIFile* pFile = unwrap<DIFile>( file );
-        return pFile->getFilename( ).data( );
+        return BorrowString( pFile->getFilename( ), length );
     }
 
-    char const* LLVMGetDIFileDirectory( LLVMMetadataRef /*DIFile*/ file )
+    char const* LLVMGetDIFileDirectory( LLVMMetadataRef /*DIFile*/ file, size_t* length )
     {
         DIFile* pFile = unwrap<DIFile>( file );
-        return pFile->getDirectory( ).data( );
+        return BorrowString( pFile->getDirectory( ), length );
     }
 
     void LLVMSetDILocation( LLVMValueRef inst, LLVMMetadataRef location )
@@ -110,6 +112,8 @@ extern "C"
                                                     , const char *Producer
                                                     , int Optimized, const char *Flags
                                                     , unsigned RuntimeVersion
+                                                    , LLVMDwarfEmissionKind EmissionKind
+                                                    , const char *SplitName
                                                     )
     {
         DIBuilder *D = unwrap( Dref );
@@ -119,10 +123,24 @@ extern "C"
                                                   , Optimized
                                                   , Flags
                                                   , RuntimeVersion
+                                                  , SplitName ? SplitName : ""
+                                                  , static_cast<DICompileUnit::DebugEmissionKind>( EmissionKind )
                                                   );
         return wrap( CU );
     }
 
+    LLVMDwarfEmissionKind LLVMDICompileUnitGetEmissionKind( LLVMMetadataRef /*DICompileUnit*/ compileUnit )
+    {
+        DICompileUnit* CU = unwrap<DICompileUnit>( compileUnit );
+        return static_cast<LLVMDwarfEmissionKind>( CU->getEmissionKind( ) );
+    }
+
+    char const* LLVMDICompileUnitGetSplitDebugFilename( LLVMMetadataRef /*DICompileUnit*/ compileUnit, size_t* length )
+    {
+        DICompileUnit* CU = unwrap<DICompileUnit>( compileUnit );
+        return BorrowString( CU->getSplitDebugFilename( ), length );
+    }
+
     LLVMMetadataRef LLVMDIBuilderCreateFile( LLVMDIBuilderRef Dref
                                              , const char *File
                                              , const char *Dir
@@ -429,6 +447,86 @@ extern "C"
         return wrap( DT );
     }
 
+    LLVMMetadataRef LLVMDIBuilderCreateCompositeTypeWithMembers( LLVMDIBuilderRef Dref
+                                                                 , unsigned Tag
+                                                                 , LLVMMetadataRef Scope
+                                                                 , const char *Name
+                                                                 , LLVMMetadataRef File
+                                                                 , unsigned Line
+                                                                 , uint64_t SizeInBits
+                                                                 , uint32_t AlignInBits
+                                                                 , unsigned Flags
+                                                                 , LLVMMetadataRef DerivedFrom
+                                                                 , LLVMDIMemberDescriptor const* Members
+                                                                 , size_t MemberCount
+                                                                 , char const* NameBlob
+                                                                 )
+    {
+        DIBuilder *D = unwrap( Dref );
+        DIScope* pScope = unwrap<DIScope>( Scope );
+        DIFile* pFile = File ? unwrap<DIFile>( File ) : nullptr;
+        DIType* pDerivedFrom = DerivedFrom ? unwrap<DIType>( DerivedFrom ) : nullptr;
+        auto flags = static_cast<DINode::DIFlags>( Flags );
+
+        switch( Tag )
+        {
+        case dwarf::DW_TAG_structure_type:
+        case dwarf::DW_TAG_class_type:
+        case dwarf::DW_TAG_union_type:
+            break;
+
+        default:
+            return nullptr;
+        }
+
+        // The members are scoped to a temporary type, which is replaced by the final type once
+        // it is created with its elements. (Creating the type without elements and attaching them
+        // afterwards would modify any existing type with the same name, scope, file, line and size
+        // as those are uniqued to the same node.)
+        DICompositeType* temp = D->createReplaceableCompositeType( Tag, Name, pScope, pFile, Line, 0, SizeInBits, AlignInBits, flags );
+
+        SmallVector<Metadata*, 16> elements;
+        elements.reserve( MemberCount );
+        for( size_t i = 0; i < MemberCount; ++i )
+        {
+            LLVMDIMemberDescriptor const& member = Members[ i ];
+            elements.push_back( D->createMemberType( temp
+                                                   , StringRef( NameBlob + member.NameOffset, member.NameLength )
+                                                   , member.File ? unwrap<DIFile>( member.File ) : nullptr
+                                                   , member.Line
+                                                   , member.SizeInBits
+                                                   , member.AlignInBits
+                                                   , member.OffsetInBits
+                                                   , static_cast<DINode::DIFlags>( member.Flags )
+                                                   , unwrap<DIType>( member.Type )
+                                                   )
+                              );
+        }
+
+        DINodeArray elementArray = D->getOrCreateArray( elements );
+        DICompositeType* CT = nullptr;
+        switch( Tag )
+        {
+        case dwarf::DW_TAG_structure_type:
+            CT = D->createStructType( pScope, Name, pFile, Line, SizeInBits, AlignInBits, flags, pDerivedFrom, elementArray );
+            break;
+
+        case dwarf::DW_TAG_class_type:
+            CT = D->createClassType( pScope, Name, pFile, Line, SizeInBits, AlignInBits, 0, flags, pDerivedFrom, elementArray );
+            break;
+
+        case dwarf::DW_TAG_union_type:
+            CT = D->createUnionType( pScope, Name, pFile, Line, SizeInBits, AlignInBits, flags, elementArray );
+            break;
+        }
+
+        // replacing the temporary re-uniques the members, and thus the type, so it is tracked
+        TrackingMDRef result( CT );
+        temp->replaceAllUsesWith( CT );
+        MDNode::deleteTemporary( temp );
+        return wrap( result.get( ) );
+    }
+
     LLVMMetadataRef LLVMDIBuilderCreateArrayType( LLVMDIBuilderRef Dref
                                                   , uint64_t SizeInBits
                                                   , uint32_t AlignInBits
@@ -668,13 +766,15 @@ extern "C"
         return wrap( pInstruction );
     }
 
-    char const* LLVMMetadataAsString( LLVMMetadataRef descriptor )
+    char const* LLVMMetadataAsString( LLVMMetadataRef descriptor, size_t* length )
     {
-        std::string Messages;
-        raw_string_ostream Msg( Messages );
+        // printing directly into the buffer reuses its capacity across calls
+        std::string& buffer = GetThreadStringBuffer( );
+        raw_string_ostream Msg( buffer );
         Metadata* d = unwrap<Metadata>( descriptor );
         d->print( Msg );
-        return LLVMCreateMessage( Msg.str( ).c_str( ) );
+        Msg.flush( );
+        return BorrowString( buffer, length );
     }
 
     void LLVMMDNodeReplaceAllUsesWith( LLVMMetadataRef oldDescriptor, LLVMMetadataRef newDescriptor )
@@ -141,6 +141,14 @@ extern "C" {
         LLVMMetadataFormatAsOperand,
     };
 
+    // Matches llvm::DICompileUnit::DebugEmissionKind
+    enum LLVMDwarfEmissionKind
+    {
+        LLVMDwarfEmissionNone = 0,
+        LLVMDwarfEmissionFull,
+        LLVMDwarfEmissionLineTablesOnly,
+    };
+
     typedef struct LLVMOpaqueDIBuilder *LLVMDIBuilderRef;
 
     void LLVMSetDILocation( LLVMValueRef inst, LLVMMetadataRef location );
@@ -165,8 +173,15 @@ extern "C" {
                                                     , int Optimized
                                                     , const char *Flags
                                                     , unsigned RuntimeVersion
+                                                    , LLVMDwarfEmissionKind EmissionKind
+                                                    , const char *SplitName
                                                     );
 
+    LLVMDwarfEmissionKind LLVMDICompileUnitGetEmissionKind( LLVMMetadataRef /*DICompileUnit*/ compileUnit );
+
+    // The name is owned by the compile unit and is not terminated; use the returned length
+    char const* LLVMDICompileUnitGetSplitDebugFilename( LLVMMetadataRef /*DICompileUnit*/ compileUnit, size_t* length );
+
     LLVMMetadataRef LLVMDIBuilderCreateFile( LLVMDIBuilderRef D
                                              , const char *File
                                              , const char *Dir
@@ -296,6 +311,39 @@ extern "C" {
                                                                  , unsigned Flags
                                                                  );
 
+    // Describes a member for LLVMDIBuilderCreateCompositeTypeWithMembers()
+    typedef struct LLVMDIMemberDescriptor
+    {
+        LLVMMetadataRef Type;
+        LLVMMetadataRef File;       // may be null
+        uint64_t SizeInBits;
+        uint64_t OffsetInBits;
+        size_t NameOffset;          // offset of the name in the shared name blob (UTF-8, not terminated)
+        size_t NameLength;
+        unsigned Line;
+        uint32_t AlignInBits;
+        unsigned Flags;
+    } LLVMDIMemberDescriptor;
+
+    // Creates a struct, class or union type (as selected by Tag) together with all of its
+    // members in one call. The members are created with a replaceable temporary type as
+    // their scope, all uses of the temporary are then replaced with the final type and the
+    // temporary is deleted. Returns null for any other tag.
+    LLVMMetadataRef LLVMDIBuilderCreateCompositeTypeWithMembers( LLVMDIBuilderRef D
+                                                                 , unsigned Tag
+                                                                 , LLVMMetadataRef Scope
+                                                                 , const char *Name
+                                                                 , LLVMMetadataRef File
+                                                                 , unsigned Line
+                                                                 , uint64_t SizeInBits
+                                                                 , uint32_t AlignInBits
+                                                                 , unsigned Flags
+                                                                 , LLVMMetadataRef DerivedFrom
+                                                                 , LLVMDIMemberDescriptor const* Members
+                                                                 , size_t MemberCount
+                                                                 , char const* NameBlob
+                                                                 );
+
     LLVMMetadataRef LLVMDIBuilderCreateMemberType( LLVMDIBuilderRef D
                                                    , LLVMMetadataRef Scope
                                                    , const char *Name
@@ -452,8 +500,10 @@ extern "C" {
                                                  , /*Instruction **/ LLVMValueRef InsertBefore
                                                  );
 
-    // caller must call LLVMDisposeMessage() on the returned string
-    char const* LLVMMetadataAsString( LLVMMetadataRef descriptor );
+    // returns a pointer and length (not terminated) for a string in a per thread buffer, it must
+    // not be disposed and remains valid until the next call returning a computed string on the
+    // same thread.
+    char const* LLVMMetadataAsString( LLVMMetadataRef descriptor, size_t* length );
 
     void LLVMMDNodeReplaceAllUsesWith( LLVMMetadataRef oldDescriptor, LLVMMetadataRef newDescriptor );
 
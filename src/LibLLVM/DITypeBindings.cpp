@@ -1,4 +1,5 @@
 #include "DITypeBindings.h"
+#include "StringResults.h"
 #include "llvm/IR/DIBuilder.h"
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/Module.h"
@@ -7,6 +8,42 @@
 
 using namespace llvm;
 
+namespace
+{
+    void FillTypeInfo( DIType const* pType, LLVMDITypeInfo& info )
+    {
+        info = LLVMDITypeInfo( );
+        info.Scope = wrap( pType->getRawScope( ) );
+        info.File = wrap( pType->getRawFile( ) );
+        info.Name = BorrowString( pType->getName( ), &info.NameLength );
+        info.SizeInBits = pType->getSizeInBits( );
+        info.OffsetInBits = pType->getOffsetInBits( );
+        info.AlignInBits = pType->getAlignInBits( );
+        info.Line = pType->getLine( );
+        info.Flags = pType->getFlags( );
+        info.Tag = pType->getTag( );
+
+        if( auto pBasic = dyn_cast<DIBasicType>( pType ) )
+        {
+            info.Encoding = pBasic->getEncoding( );
+        }
+        else if( auto pDerived = dyn_cast<DIDerivedType>( pType ) )
+        {
+            info.BaseType = wrap( pDerived->getRawBaseType( ) );
+            info.ExtraData = wrap( pDerived->getRawExtraData( ) );
+        }
+        else if( auto pComposite = dyn_cast<DICompositeType>( pType ) )
+        {
+            info.BaseType = wrap( pComposite->getRawBaseType( ) );
+            info.Elements = wrap( pComposite->getRawElements( ) );
+            info.VTableHolder = wrap( pComposite->getRawVTableHolder( ) );
+            info.TemplateParams = wrap( pComposite->getRawTemplateParams( ) );
+            info.Identifier = BorrowString( pComposite->getIdentifier( ), &info.IdentifierLength );
+            info.RuntimeLang = pComposite->getRuntimeLang( );
+        }
+    }
+}
+
 extern "C"
 {
     unsigned LLVMDITypeGetLine( LLVMMetadataRef typeRef )
@@ -45,10 +82,10 @@ extern "C"
         return wrap( pType->getScope( ) );
     }
 
-    char const* LLVMDITypeGetName( LLVMMetadataRef typeRef )
+    char const* LLVMDITypeGetName( LLVMMetadataRef typeRef, size_t* length )
     {
         DIType* pType = unwrap<DIType>( typeRef );
-        return pType->getName( ).data( );
+        return BorrowString( pType->getName( ), length );
     }
 
     LLVMMetadataRef LLVMDIScopeGetFile( LLVMMetadataRef scopeRef )
@@ -56,4 +93,17 @@ extern "C"
         DIScope* pType = unwrap<DIScope>( scopeRef );
         return wrap( pType->getFile() );
     }
+
+    void LLVMDITypeGetInfo( LLVMMetadataRef typeRef, LLVMDITypeInfo* info )
+    {
+        FillTypeInfo( unwrap<DIType>( typeRef ), *info );
+    }
+
+    void LLVMDITypeGetInfoArray( LLVMMetadataRef const* types, size_t count, LLVMDITypeInfo* infos )
+    {
+        for( size_t i = 0; i < count; ++i )
+        {
+            FillTypeInfo( unwrap<DIType>( types[ i ] ), infos[ i ] );
+        }
+    }
 }
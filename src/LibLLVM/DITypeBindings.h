@@ -14,9 +14,40 @@ extern "C" {
     uint64_t LLVMDITypeGetOffsetInBits( LLVMMetadataRef typeRef );
     unsigned LLVMDITypeGetFlags( LLVMMetadataRef typeRef );
     LLVMMetadataRef LLVMDITypeGetScope( LLVMMetadataRef typeRef );
-    char const* LLVMDITypeGetName( LLVMMetadataRef typeRef );
+    // The name is owned by the type node and is not terminated; use the returned length
+    char const* LLVMDITypeGetName( LLVMMetadataRef typeRef, size_t* length );
     LLVMMetadataRef LLVMDIScopeGetFile( LLVMMetadataRef typeRef );
 
+    // All of the fields of a DIType. Fields that don't apply to the kind of type are null or 0.
+    // The strings are owned by the type node and are not terminated.
+    typedef struct LLVMDITypeInfo
+    {
+        LLVMMetadataRef Scope;
+        LLVMMetadataRef File;
+        LLVMMetadataRef BaseType;       // derived and composite types
+        LLVMMetadataRef ExtraData;      // derived types
+        LLVMMetadataRef Elements;       // composite types
+        LLVMMetadataRef VTableHolder;   // composite types
+        LLVMMetadataRef TemplateParams; // composite types
+        char const* Name;
+        size_t NameLength;
+        char const* Identifier;         // composite types
+        size_t IdentifierLength;
+        uint64_t SizeInBits;
+        uint64_t OffsetInBits;
+        uint32_t AlignInBits;
+        unsigned Line;
+        unsigned Flags;
+        unsigned Tag;
+        unsigned Encoding;              // basic types
+        unsigned RuntimeLang;           // composite types
+    } LLVMDITypeInfo;
+
+    void LLVMDITypeGetInfo( LLVMMetadataRef typeRef, LLVMDITypeInfo* info );
+
+    // Fills infos[ i ] for each of types[ i ]
+    void LLVMDITypeGetInfoArray( LLVMMetadataRef const* types, size_t count, LLVMDITypeInfo* infos );
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,400 @@
+#include "FunctionPartitioning.h"
+#include <llvm/ADT/SetVector.h>
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringSet.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/DebugInfo.h>
+#include <llvm/IR/DebugInfoMetadata.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Transforms/Utils/ValueMapper.h>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+namespace
+{
+    struct LocalSymbolInfo
+    {
+        std::string Name;
+        GlobalValue::LinkageTypes Linkage;
+        GlobalValue::VisibilityTypes Visibility;
+        bool Unnamed;
+    };
+
+    // Partitions are re-linked into the original module by name, so symbols with local
+    // linkage are temporarily made external (and hidden) to keep the linker from renaming
+    // them. The original linkage, and lack of a name, is restored once all partitions are
+    // merged back.
+    std::vector<LocalSymbolInfo> ExternalizeLocals( Module& M )
+    {
+        std::vector<LocalSymbolInfo> locals;
+        for( GlobalValue& gv : M.global_values( ) )
+        {
+            if( !gv.hasLocalLinkage( ) )
+                continue;
+
+            bool unnamed = !gv.hasName( );
+            if( unnamed )
+                gv.setName( "llvmnet.anon" );
+
+            locals.push_back( { gv.getName( ).str( ), gv.getLinkage( ), gv.getVisibility( ), unnamed } );
+            gv.setLinkage( GlobalValue::ExternalLinkage );
+            gv.setVisibility( GlobalValue::HiddenVisibility );
+        }
+
+        return locals;
+    }
+
+    void RestoreLocals( Module& M, std::vector<LocalSymbolInfo> const& locals )
+    {
+        for( auto const& info : locals )
+        {
+            GlobalValue* gv = M.getNamedValue( info.Name );
+            if( gv == nullptr )
+                continue;
+
+            gv->setVisibility( info.Visibility );
+            gv->setLinkage( info.Linkage );
+            if( info.Unnamed )
+                gv->setName( "" );
+        }
+    }
+
+    struct FunctionLayoutInfo
+    {
+        std::string Name;
+        Comdat* FunctionComdat;
+    };
+
+    // The linker replaces each relinked definition with a new function at the end of the module,
+    // which takes the comdat of the partition's definition (none, see ReduceToPartition). So the
+    // order and comdats of the functions are recorded to restore them after the merge.
+    std::vector<FunctionLayoutInfo> GetFunctionLayout( Module& M )
+    {
+        std::vector<FunctionLayoutInfo> layout;
+        for( Function& F : M )
+            layout.push_back( { F.getName( ).str( ), F.getComdat( ) } );
+
+        return layout;
+    }
+
+    void RestoreFunctionLayout( Module& M, std::vector<FunctionLayoutInfo> const& layout )
+    {
+        // functions created by the transforms (e.g. library function declarations) stay after the originals
+        SmallPtrSet<Function*, 16> originals;
+        std::vector<Function*> ordered;
+        for( auto const& info : layout )
+        {
+            Function* F = M.getFunction( info.Name );
+            if( F == nullptr )
+                continue;
+
+            F->setComdat( info.FunctionComdat );
+            originals.insert( F );
+            ordered.push_back( F );
+        }
+
+        for( Function& F : M )
+        {
+            if( originals.count( &F ) == 0 )
+                ordered.push_back( &F );
+        }
+
+        auto& functions = M.getFunctionList( );
+        for( Function* F : ordered )
+            functions.splice( functions.end( ), functions, F->getIterator( ) );
+    }
+
+    // Named metadata listing the distinct debug information nodes of the original module in each
+    // partition, so that the copies of them in a transformed partition can be mapped back onto the
+    // originals.
+    char const PartitionAnchorsName[ ] = "llvmnet.partition.anchors";
+
+    std::vector<MDNode*> GetDistinctDebugInfoNodes( Module& M )
+    {
+        DebugInfoFinder finder;
+        finder.processModule( M );
+        for( Function& F : M )
+        {
+            for( Instruction& I : instructions( F ) )
+            {
+                if( auto declare = dyn_cast<DbgDeclareInst>( &I ) )
+                    finder.processDeclare( M, declare );
+                else if( auto value = dyn_cast<DbgValueInst>( &I ) )
+                    finder.processValue( M, value );
+
+                if( DILocation* location = I.getDebugLoc( ) )
+                    finder.processLocation( M, location );
+            }
+        }
+
+        SetVector<MDNode*> nodes;
+        for( DICompileUnit* unit : finder.compile_units( ) )
+            nodes.insert( unit );
+
+        for( DISubprogram* subprogram : finder.subprograms( ) )
+            nodes.insert( subprogram );
+
+        for( DIScope* scope : finder.scopes( ) )
+            nodes.insert( scope );
+
+        for( DIType* type : finder.types( ) )
+            nodes.insert( type );
+
+        std::vector<MDNode*> distinctNodes;
+        for( MDNode* node : nodes )
+        {
+            if( node->isDistinct( ) )
+                distinctNodes.push_back( node );
+        }
+
+        return distinctNodes;
+    }
+
+    // Parsing a partition into the original context creates new copies of its distinct nodes, and
+    // the linker would append the copied compile units to llvm.dbg.cu. So the partition's compile
+    // unit list is dropped and its functions are remapped to refer to the original compile units,
+    // subprograms and scopes.
+    bool MapDebugInfoToOriginals( Module& partition, std::vector<MDNode*> const& anchors )
+    {
+        NamedMDNode* anchorList = partition.getNamedMetadata( PartitionAnchorsName );
+        if( anchorList == nullptr )
+            return anchors.empty( );
+
+        if( anchorList->getNumOperands( ) != anchors.size( ) )
+            return false;
+
+        ValueToValueMapTy map;
+        for( unsigned i = 0; i < anchorList->getNumOperands( ); ++i )
+            map.MD( )[ anchorList->getOperand( i ) ].reset( anchors[ i ] );
+
+        partition.eraseNamedMetadata( anchorList );
+        if( NamedMDNode* unitList = partition.getNamedMetadata( "llvm.dbg.cu" ) )
+            partition.eraseNamedMetadata( unitList );
+
+        ValueMapper mapper( map, RF_IgnoreMissingLocals | RF_MoveDistinctMDs );
+        for( Function& F : partition )
+        {
+            if( !F.isDeclaration( ) )
+                mapper.remapFunction( F );
+        }
+
+        return true;
+    }
+
+    // Greedy longest processing time assignment of function definitions to partitions
+    // using the instruction count as the estimate of the optimization cost.
+    std::vector<std::vector<std::string>> AssignFunctions( Module& M, unsigned partitionCount )
+    {
+        std::vector<std::pair<size_t, Function*>> functions;
+        for( Function& F : M )
+        {
+            if( F.isDeclaration( ) )
+                continue;
+
+            size_t size = 0;
+            for( BasicBlock const& BB : F )
+                size += BB.size( );
+
+            functions.emplace_back( size, &F );
+        }
+
+        std::stable_sort( functions.begin( ), functions.end( ), [ ]( auto const& lhs, auto const& rhs ) { return lhs.first > rhs.first; } );
+
+        std::vector<std::vector<std::string>> partitions( partitionCount );
+        std::vector<size_t> load( partitionCount, 0 );
+        for( auto const& entry : functions )
+        {
+            auto target = std::min_element( load.begin( ), load.end( ) ) - load.begin( );
+            load[ target ] += entry.first;
+            partitions[ target ].push_back( entry.second->getName( ).str( ) );
+        }
+
+        return partitions;
+    }
+
+    // Reduces a full copy of the module to only the function definitions owned by a partition,
+    // everything else is left as a declaration resolved against the original module when the
+    // partition is linked back in. Constant globals keep their initializers, so loads of them are
+    // still folded, and are turned into declarations by DeclareConstants after the transform.
+    // Returns the names of the constant globals kept.
+    std::vector<std::string> ReduceToPartition( Module& M, std::vector<std::string> const& ownedFunctions )
+    {
+        StringSet<> owned;
+        for( auto const& name : ownedFunctions )
+            owned.insert( name );
+
+        // aliases must refer to definitions, the originals remain in the destination module
+        for( auto it = M.alias_begin( ); it != M.alias_end( ); )
+        {
+            GlobalAlias& alias = *it++;
+            alias.replaceAllUsesWith( alias.getAliasee( ) );
+            alias.eraseFromParent( );
+        }
+
+        // The comdats are dropped from the owned definitions too, otherwise the comdat resolution
+        // of the linker keeps the original definition of an 'any' comdat instead of the transformed
+        // one. RestoreFunctionLayout restores the comdats in the original module.
+        for( Function& F : M )
+        {
+            if( F.isDeclaration( ) )
+                continue;
+
+            F.setComdat( nullptr );
+            if( owned.count( F.getName( ) ) == 0 )
+                F.deleteBody( );
+        }
+
+        std::vector<std::string> constants;
+        for( GlobalVariable& gv : M.globals( ) )
+        {
+            if( gv.isDeclaration( ) )
+                continue;
+
+            gv.setComdat( nullptr );
+            if( gv.isConstant( ) && gv.hasName( ) )
+            {
+                constants.push_back( gv.getName( ).str( ) );
+                continue;
+            }
+
+            gv.setInitializer( nullptr );
+            gv.setLinkage( GlobalValue::ExternalLinkage );
+        }
+
+        // Only the compile units and the debug info anchors are kept so debug info of the linked
+        // functions remains valid
+        std::vector<NamedMDNode*> namedMetadata;
+        for( NamedMDNode& node : M.named_metadata( ) )
+        {
+            if( node.getName( ) != "llvm.dbg.cu"
+             && node.getName( ) != "llvm.module.flags"
+             && node.getName( ) != PartitionAnchorsName
+              )
+            {
+                namedMetadata.push_back( &node );
+            }
+        }
+
+        for( NamedMDNode* node : namedMetadata )
+            M.eraseNamedMetadata( node );
+
+        return constants;
+    }
+
+    // The definitions of the constants remain in the original module, so the partition only
+    // refers to them. (Globals created by the transform are linked in as they are.)
+    void DeclareConstants( Module& M, std::vector<std::string> const& constants )
+    {
+        for( auto const& name : constants )
+        {
+            GlobalVariable* gv = M.getNamedGlobal( name );
+            if( gv == nullptr || gv->isDeclaration( ) )
+                continue;
+
+            gv->setInitializer( nullptr );
+            gv->setLinkage( GlobalValue::ExternalLinkage );
+        }
+    }
+}
+
+bool RunOnFunctionPartitions( Module& M
+                            , unsigned workerCount
+                            , std::function<bool( Module& partition )> const& transform
+                            )
+{
+    auto locals = ExternalizeLocals( M );
+    auto layout = GetFunctionLayout( M );
+    auto partitions = AssignFunctions( M, workerCount );
+
+    auto anchors = GetDistinctDebugInfoNodes( M );
+    NamedMDNode* anchorList = M.getOrInsertNamedMetadata( PartitionAnchorsName );
+    for( MDNode* node : anchors )
+        anchorList->addOperand( node );
+
+    SmallVector<char, 0> bitcode;
+    {
+        raw_svector_ostream bitcodeStream( bitcode );
+        WriteBitcodeToFile( &M, bitcodeStream );
+    }
+
+    M.eraseNamedMetadata( anchorList );
+
+    // every worker transforms its partition in a private context and hands the result back as bitcode.
+    std::vector<SmallVector<char, 0>> results( partitions.size( ) );
+    std::atomic<bool> failed( false );
+    {
+        ThreadPool pool( workerCount );
+        for( size_t i = 0; i < partitions.size( ); ++i )
+        {
+            if( partitions[ i ].empty( ) )
+                continue;
+
+            pool.async( [ & ]( size_t index )
+            {
+                LLVMContext context;
+                auto partModule = parseBitcodeFile( MemoryBufferRef( StringRef( bitcode.data( ), bitcode.size( ) ), "<partition>" ), context );
+                if( !partModule )
+                {
+                    consumeError( partModule.takeError( ) );
+                    failed = true;
+                    return;
+                }
+
+                auto constants = ReduceToPartition( **partModule, partitions[ index ] );
+                if( !transform( **partModule ) )
+                {
+                    failed = true;
+                    return;
+                }
+
+                DeclareConstants( **partModule, constants );
+
+                raw_svector_ostream resultStream( results[ index ] );
+                WriteBitcodeToFile( partModule->get( ), resultStream );
+            }, i );
+        }
+
+        pool.wait( );
+    }
+
+    // merge the transformed bodies back into the original module, the function definitions
+    // from each partition override the originals.
+    for( auto const& result : results )
+    {
+        if( failed || result.empty( ) )
+            continue;
+
+        auto partModule = parseBitcodeFile( MemoryBufferRef( StringRef( result.data( ), result.size( ) ), "<partition>" ), M.getContext( ) );
+        if( !partModule )
+        {
+            consumeError( partModule.takeError( ) );
+            failed = true;
+            continue;
+        }
+
+        if( !MapDebugInfoToOriginals( **partModule, anchors ) )
+        {
+            failed = true;
+            continue;
+        }
+
+        if( Linker::linkModules( M, std::move( *partModule ), Linker::Flags::OverrideFromSrc ) )
+            failed = true;
+    }
+
+    RestoreFunctionLayout( M, layout );
+    RestoreLocals( M, locals );
+    return !failed;
+}
@@ -0,0 +1,25 @@
+#ifndef _FUNCTION_PARTITIONING_H_
+#define _FUNCTION_PARTITIONING_H_
+
+#include <functional>
+#include <llvm/IR/Module.h>
+
+// Runs a function level transformation over the function definitions of a module across a
+// pool of worker threads. Since an LLVMContext is not thread safe, the definitions are
+// partitioned (balanced by instruction count) into workerCount copies of the module, each
+// in a private context. transform is called on a worker thread for each partition and must
+// not share any state with other threads (e.g. target machines or pass managers). The
+// transformed definitions are linked back into M, replacing the originals. They keep their
+// order, comdats, and the compile units and subprograms of M. Constant globals keep their
+// initializers in the partitions so the transform can still fold loads of them.
+//
+// The partitioning and the order of the merge are independent of thread scheduling, so the
+// results are deterministic. Any function references held for M are invalidated.
+//
+// Returns false if any transform returns false or the results fail to link.
+bool RunOnFunctionPartitions( llvm::Module& M
+                            , unsigned workerCount
+                            , std::function<bool( llvm::Module& partition )> const& transform
+                            );
+
+#endif
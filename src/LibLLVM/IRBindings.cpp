@@ -21,6 +21,8 @@
 #include "llvm/IR/Module.h"
 #include "llvm/IR/CallSite.h"
 #include "llvm/IR/DebugInfoMetadata.h"
+#include "llvm/IR/TrackingMDRef.h"
+#include "llvm/ADT/SmallVector.h"
 #include <type_traits>
 
 using namespace llvm;
@@ -32,6 +34,29 @@ extern "C"
         *pVersionInfo = { LLVM_VERSION_MAJOR, LLVM_VERSION_MINOR, LLVM_VERSION_PATCH, LLVM_VERSION_STRING };
     }
 
+    void LLVMContextSetDiscardValueNames( LLVMContextRef C, LLVMBool discard )
+    {
+        unwrap( C )->setDiscardValueNames( !!discard );
+    }
+
+    LLVMBool LLVMContextShouldDiscardValueNames( LLVMContextRef C )
+    {
+        return unwrap( C )->shouldDiscardValueNames( );
+    }
+
+    void LLVMContextSetODRUniquingDebugTypes( LLVMContextRef C, LLVMBool enable )
+    {
+        if( enable )
+            unwrap( C )->enableDebugTypeODRUniquing( );
+        else
+            unwrap( C )->disableDebugTypeODRUniquing( );
+    }
+
+    LLVMBool LLVMContextIsODRUniquingDebugTypes( LLVMContextRef C )
+    {
+        return unwrap( C )->isODRUniquingDebugTypes( );
+    }
+
     LLVMMetadataRef LLVMConstantAsMetadata( LLVMValueRef C )
     {
         return wrap( ConstantAsMetadata::get( unwrap<Constant>( C ) ) );
@@ -92,6 +117,37 @@ extern "C"
         MDNode::deleteTemporary( Node );
     }
 
+    void LLVMMetadataReplaceAllTemporaries( LLVMMetadataRef const* temporaries, LLVMMetadataRef const* replacements, size_t count )
+    {
+        // tracking the replacements keeps them current when one of them is itself a temporary
+        // being replaced or is re-uniqued as a result of an earlier replacement
+        SmallVector<TrackingMDRef, 16> trackedReplacements;
+        trackedReplacements.reserve( count );
+        for( size_t i = 0; i < count; ++i )
+        {
+            trackedReplacements.emplace_back( unwrap( replacements[ i ] ) );
+        }
+
+        for( size_t i = 0; i < count; ++i )
+        {
+            unwrap<MDNode>( temporaries[ i ] )->replaceAllUsesWith( trackedReplacements[ i ].get( ) );
+        }
+
+        for( size_t i = 0; i < count; ++i )
+        {
+            MDNode::deleteTemporary( unwrap<MDNode>( temporaries[ i ] ) );
+        }
+
+        for( auto& replacement : trackedReplacements )
+        {
+            auto pNode = dyn_cast_or_null<MDNode>( replacement.get( ) );
+            if( pNode != nullptr && !pNode->isResolved( ) )
+            {
+                pNode->resolveCycles( );
+            }
+        }
+    }
+
     void LLVMSetCurrentDebugLocation2( LLVMBuilderRef Bref
                                        , unsigned Line
                                        , unsigned Col
@@ -36,6 +36,18 @@ extern "C" {
 
     void LLVMGetVersionInfo( LLVMVersionInfo* pVersionInfo );
 
+    // When set, the names of values other than globals are not retained, which saves the
+    // memory of the name strings. Names are still available for globals and the setting
+    // only affects values named after it is set.
+    void LLVMContextSetDiscardValueNames( LLVMContextRef C, LLVMBool discard );
+    LLVMBool LLVMContextShouldDiscardValueNames( LLVMContextRef C );
+
+    // When set, composite debug types with a unique identifier are uniqued by that identifier
+    // (One Definition Rule) as modules are loaded from bitcode into the context, so modules
+    // sharing the same types reuse a single definition instead of creating duplicates.
+    void LLVMContextSetODRUniquingDebugTypes( LLVMContextRef C, LLVMBool enable );
+    LLVMBool LLVMContextIsODRUniquingDebugTypes( LLVMContextRef C );
+
     typedef struct LLVMOpaqueMetadata* LLVMMetadataRef;
     typedef struct LLVMOpaqueMDOperand* LLVMMDOperandRef;
 
@@ -50,6 +62,12 @@ extern "C" {
     void LLVMAddNamedMetadataOperand2( LLVMModuleRef M, const char *name, LLVMMetadataRef Val );
     void LLVMSetMetadata2( LLVMValueRef Inst, unsigned KindID, LLVMMetadataRef MD );
     void LLVMMetadataReplaceAllUsesWith( LLVMMetadataRef MD, LLVMMetadataRef New );
+
+    // Replaces all uses of each temporary node with its replacement and deletes the temporaries.
+    // A replacement may refer to, or be, another temporary of the same call. Once all of the
+    // replacements are done, cycles are resolved for the replacements that are still unresolved,
+    // which visits each affected subgraph only once.
+    void LLVMMetadataReplaceAllTemporaries( LLVMMetadataRef const* temporaries, LLVMMetadataRef const* replacements, size_t count );
     void LLVMSetCurrentDebugLocation2( LLVMBuilderRef Bref, unsigned Line, unsigned Col, LLVMMetadataRef Scope, LLVMMetadataRef InlinedAt );
 
     LLVMBool LLVMIsTemporary( LLVMMetadataRef M );
@@ -58,8 +76,9 @@ extern "C" {
     LLVMBool LLVMIsDistinct( LLVMMetadataRef M );
 
     void LLVMMDNodeResolveCycles( LLVMMetadataRef M );
-    char const* LLVMGetDIFileName( LLVMMetadataRef /*DIFile*/ file );
-    char const* LLVMGetDIFileDirectory( LLVMMetadataRef /*DIFile*/ file );
+    // The names are owned by the file node and are not terminated; use the returned length
+    char const* LLVMGetDIFileName( LLVMMetadataRef /*DIFile*/ file, size_t* length );
+    char const* LLVMGetDIFileDirectory( LLVMMetadataRef /*DIFile*/ file, size_t* length );
 
     LLVMMetadataRef LLVMFunctionGetSubprogram( LLVMValueRef function );
     void LLVMFunctionSetSubprogram( LLVMValueRef function, LLVMMetadataRef subprogram );
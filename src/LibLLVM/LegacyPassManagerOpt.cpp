@@ -16,6 +16,10 @@
 // ported and modified from opt.cpp in LLVM to allow for use as an API instead of trying to expose all of
 // the legacy pass manager support, since the pass management is undergoing a significant transition
 // it is best not to build out projectionts to depend on the legacy variant.
+#include "LegacyPassManagerOpt.h"
+#include "FunctionPartitioning.h"
+#include "TargetMachineBindings.h"
+#include <llvm/ADT/STLExtras.h>
 #include <llvm/ADT/Triple.h>
 #include <llvm/Analysis/CallGraph.h>
 #include <llvm/Analysis/CallGraphSCCPass.h>
@@ -60,6 +64,9 @@
 #include <llvm-c/TargetMachine.h>
 #include <algorithm>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 using namespace llvm;
 
 static TargetMachine *unwrap( LLVMTargetMachineRef P )
@@ -166,6 +173,32 @@ static cl::opt<bool> PassRemarksWithHotness(
     cl::desc( "With PGO, include profile count in optimization remarks" ),
     cl::Hidden );
 
+/// Applies the context level options to the module's own context for the duration
+/// of a call and restores the previous settings afterwards.
+class ScopedContextOptions {
+public:
+    ScopedContextOptions( LLVMContext &Context, LLVMLegacyOptimizerOptions const& Opts )
+        : Context( Context )
+        , DiscardValueNames( Context.shouldDiscardValueNames( ) )
+        , HotnessRequested( Context.getDiagnosticHotnessRequested( ) ) {
+        if( Opts.DiscardValueNames )
+            Context.setDiscardValueNames( true );
+
+        if( Opts.PassRemarksWithHotness )
+            Context.setDiagnosticHotnessRequested( true );
+    }
+
+    ~ScopedContextOptions( ) {
+        Context.setDiscardValueNames( DiscardValueNames );
+        Context.setDiagnosticHotnessRequested( HotnessRequested );
+    }
+
+private:
+    LLVMContext &Context;
+    bool DiscardValueNames;
+    bool HotnessRequested;
+};
+
 /// This routine adds optimization passes based on selected optimization level,
 /// OptLevel.
 ///
@@ -173,7 +206,8 @@ static cl::opt<bool> PassRemarksWithHotness(
 static void AddOptimizationPasses( legacy::PassManagerBase &MPM,
     legacy::FunctionPassManager &FPM,
     TargetMachine *TM, unsigned OptLevel,
-    unsigned SizeLevel ) {
+    unsigned SizeLevel,
+    LLVMLegacyOptimizerOptions const& Opts ) {
     //if( !NoVerify || VerifyEach )
     //    FPM.add( createVerifierPass( ) ); // Verify that input is correct
 
@@ -190,12 +224,11 @@ static void AddOptimizationPasses( legacy::PassManagerBase &MPM,
     else {
         Builder.Inliner = createAlwaysInlinerLegacyPass( );
     }
-    Builder.DisableUnitAtATime = !UnitAtATime;
-    Builder.DisableUnrollLoops = ( DisableLoopUnrolling.getNumOccurrences( ) > 0 ) ?
-        DisableLoopUnrolling : OptLevel == 0;
+    Builder.DisableUnitAtATime = !!Opts.DisableUnitAtATime;
+    Builder.DisableUnrollLoops = Opts.DisableLoopUnrolling || OptLevel == 0;
 
     // This is final, unless there is a #pragma vectorize enable
-    if( DisableLoopVectorization )
+    if( Opts.DisableLoopVectorization )
         Builder.LoopVectorize = false;
     // If option wasn't forced via cmd line (-vectorize-loops, -loop-vectorize)
     else if( !Builder.LoopVectorize )
@@ -203,7 +236,7 @@ static void AddOptimizationPasses( legacy::PassManagerBase &MPM,
 
     // When #pragma vectorize is on for SLP, do the same as above
     Builder.SLPVectorize =
-        DisableSLPVectorization ? false : OptLevel > 1 && SizeLevel < 2;
+        Opts.DisableSLPVectorization ? false : OptLevel > 1 && SizeLevel < 2;
 
     // Add target-specific passes that need to run as early as possible.
     if( TM )
@@ -213,7 +246,7 @@ static void AddOptimizationPasses( legacy::PassManagerBase &MPM,
         TM->addEarlyAsPossiblePasses( PM );
     } );
 
-    if( Coroutines )
+    if( Opts.EnableCoroutines )
         addCoroutinePassesToExtensionPoints( Builder );
 
     Builder.populateFunctionPassManager( FPM );
@@ -259,23 +292,101 @@ void LLVMInitializePassesForLegacyOpt( )
     initializeUnreachableBlockElimLegacyPassPass( Registry );
 }
 
-void LLVMRunLegacyOptimizer( LLVMModuleRef Mref, LLVMTargetMachineRef TMref ) {
+namespace
+{
+    struct StandardPipeline
+    {
+        char const* Name;
+        unsigned OptLevel;
+        unsigned SizeLevel;
+    };
+
+    StandardPipeline const StandardPipelines[ ] =
+    {
+        { "O1", 1, 0 },
+        { "O2", 2, 0 },
+        { "Os", 2, 1 },
+        { "Oz", 2, 2 },
+        { "O3", 3, 0 },
+    };
+
+    // Builds the ordered pass list for LLVMLegacyOptimizerOptions from the opt style
+    // command line options. Options are only read, so the command line state is left
+    // intact for subsequent calls.
+    std::string GetPassListFromCommandLine( )
+    {
+        std::vector<std::pair<unsigned, std::string>> entries;
+        if( StandardLinkOpts )
+            entries.emplace_back( StandardLinkOpts.getPosition( ), "std-link-opts" );
+
+        cl::opt<bool> const* optLevelOptions[ ] = { &OptLevelO1, &OptLevelO2, &OptLevelOs, &OptLevelOz, &OptLevelO3 };
+        for( unsigned i = 0; i < array_lengthof( optLevelOptions ); ++i )
+        {
+            if( *optLevelOptions[ i ] )
+                entries.emplace_back( optLevelOptions[ i ]->getPosition( ), StandardPipelines[ i ].Name );
+        }
+
+        for( unsigned i = 0; i < PassList.size( ); ++i )
+            entries.emplace_back( PassList.getPosition( i ), PassList[ i ]->getPassArgument( ).str( ) );
+
+        std::stable_sort( entries.begin( ), entries.end( ), []( auto const& lhs, auto const& rhs ) { return lhs.first < rhs.first; } );
+
+        std::string retVal;
+        for( auto const& entry : entries )
+        {
+            if( !retVal.empty( ) )
+                retVal += ',';
+
+            retVal += entry.second;
+        }
+
+        return retVal;
+    }
+}
+
+void LLVMInitializeLegacyOptimizerOptions( LLVMLegacyOptimizerOptions* options )
+{
+    *options = LLVMLegacyOptimizerOptions{ };
+}
 
-    SMDiagnostic Err;
-    LLVMContext Context;
+void LLVMRunLegacyOptimizer( LLVMModuleRef Mref, LLVMTargetMachineRef TMref ) {
 
-    Context.setDiscardValueNames( DiscardValueNames );
-    Context.enableDebugTypeODRUniquing( );
+    std::string passList = GetPassListFromCommandLine( );
+
+    LLVMLegacyOptimizerOptions options;
+    LLVMInitializeLegacyOptimizerOptions( &options );
+    options.Passes = passList.c_str( );
+    options.DisableUnitAtATime = !UnitAtATime;
+    options.DisableLoopUnrolling = DisableLoopUnrolling;
+    options.DisableLoopVectorization = DisableLoopVectorization;
+    options.DisableSLPVectorization = DisableSLPVectorization;
+    options.DisableSimplifyLibCalls = DisableSimplifyLibCalls;
+    options.EnableCoroutines = Coroutines;
+    options.DiscardValueNames = DiscardValueNames;
+    options.PassRemarksWithHotness = PassRemarksWithHotness;
+
+    // the pass list is built from registered passes so it can't fail
+    char* errorMessage = nullptr;
+    LLVMRunLegacyOptimizerWithOptions( Mref, TMref, &options, &errorMessage );
+    if( errorMessage != nullptr )
+        LLVMDisposeMessage( errorMessage );
+}
 
-    if( PassRemarksWithHotness )
-        Context.setDiagnosticHotnessRequested( true );
+LLVMBool LLVMRunLegacyOptimizerWithOptions( LLVMModuleRef Mref
+                                          , LLVMTargetMachineRef TMref
+                                          , LLVMLegacyOptimizerOptions const* options
+                                          , char** errorMessage
+                                          ) {
+    LLVMLegacyOptimizerOptions const& Opts = *options;
 
     auto M = unwrap( Mref );
 
+    // The options apply to the values created while optimizing, names of existing
+    // values are kept (see LLVMContextSetDiscardValueNames to drop them on creation).
+    ScopedContextOptions ContextOptions( M->getContext( ), Opts );
+
     Triple ModuleTriple( M->getTargetTriple( ) );
-    std::string CPUStr, FeaturesStr;
     TargetMachine *TM = unwrap( TMref );
-    const TargetOptions Options = InitTargetOptionsFromCodeGenFlags( );
 
     // Create a PassManager to hold and optimize the collection of passes we are
     // about to build.
@@ -285,8 +396,8 @@ void LLVMRunLegacyOptimizer( LLVMModuleRef Mref, LLVMTargetMachineRef TMref ) {
     // Add an appropriate TargetLibraryInfo pass for the module's triple.
     TargetLibraryInfoImpl TLII( ModuleTriple );
 
-    // The -disable-simplify-libcalls flag actually disables all builtin optzns.
-    if( DisableSimplifyLibCalls )
+    // The DisableSimplifyLibCalls option actually disables all builtin optzns.
+    if( Opts.DisableSimplifyLibCalls )
         TLII.disableAllFunctions( );
     Passes.add( new TargetLibraryInfoWrapperPass( TLII ) );
 
@@ -294,95 +405,83 @@ void LLVMRunLegacyOptimizer( LLVMModuleRef Mref, LLVMTargetMachineRef TMref ) {
     Passes.add( createTargetTransformInfoWrapperPass( TM ? TM->getTargetIRAnalysis( )
         : TargetIRAnalysis( ) ) );
 
+    // The function passes of any standard pipelines are collected into a single
+    // function pass manager that is run on all functions before the module passes.
     std::unique_ptr<legacy::FunctionPassManager> FPasses;
-    if( OptLevelO1 || OptLevelO2 || OptLevelOs || OptLevelOz || OptLevelO3 ) {
-        FPasses.reset( new legacy::FunctionPassManager( M ) );
-        FPasses->add( createTargetTransformInfoWrapperPass(
-            TM ? TM->getTargetIRAnalysis( ) : TargetIRAnalysis( ) ) );
-    }
+    std::vector<StandardPipeline const*> FPassesPipelines;
 
-    // Create a new optimization pass for each one specified on the command line
-    for( unsigned i = 0; i < PassList.size( ); ++i ) {
-        if( StandardLinkOpts &&
-            StandardLinkOpts.getPosition( ) < PassList.getPosition( i ) ) {
+    SmallVector<StringRef, 16> passNames;
+    StringRef( Opts.Passes == nullptr ? "" : Opts.Passes ).split( passNames, ',', -1, false );
+    for( StringRef passName : passNames ) {
+        passName = passName.trim( );
+        if( passName == "std-link-opts" ) {
             AddStandardLinkPasses( Passes );
-            StandardLinkOpts = false;
-        }
-
-        if( OptLevelO1 && OptLevelO1.getPosition( ) < PassList.getPosition( i ) ) {
-            AddOptimizationPasses( Passes, *FPasses, TM, 1, 0 );
-            OptLevelO1 = false;
-        }
-
-        if( OptLevelO2 && OptLevelO2.getPosition( ) < PassList.getPosition( i ) ) {
-            AddOptimizationPasses( Passes, *FPasses, TM, 2, 0 );
-            OptLevelO2 = false;
+            continue;
         }
 
-        if( OptLevelOs && OptLevelOs.getPosition( ) < PassList.getPosition( i ) ) {
-            AddOptimizationPasses( Passes, *FPasses, TM, 2, 1 );
-            OptLevelOs = false;
+        auto pipeline = std::find_if( std::begin( StandardPipelines ), std::end( StandardPipelines ), [ & ]( StandardPipeline const& p ) { return passName == p.Name; } );
+        if( pipeline != std::end( StandardPipelines ) ) {
+            if( !FPasses ) {
+                FPasses.reset( new legacy::FunctionPassManager( M ) );
+                FPasses->add( createTargetTransformInfoWrapperPass(
+                    TM ? TM->getTargetIRAnalysis( ) : TargetIRAnalysis( ) ) );
+            }
+
+            AddOptimizationPasses( Passes, *FPasses, TM, pipeline->OptLevel, pipeline->SizeLevel, Opts );
+            FPassesPipelines.push_back( pipeline );
+            continue;
         }
 
-        if( OptLevelOz && OptLevelOz.getPosition( ) < PassList.getPosition( i ) ) {
-            AddOptimizationPasses( Passes, *FPasses, TM, 2, 2 );
-            OptLevelOz = false;
+        const PassInfo *PassInf = PassRegistry::getPassRegistry( )->getPassInfo( passName );
+        Pass *P = nullptr;
+        if( PassInf != nullptr ) {
+            if( PassInf->getTargetMachineCtor( ) )
+                P = PassInf->getTargetMachineCtor( )( TM );
+            else if( PassInf->getNormalCtor( ) )
+                P = PassInf->getNormalCtor( )( );
         }
 
-        if( OptLevelO3 && OptLevelO3.getPosition( ) < PassList.getPosition( i ) ) {
-            AddOptimizationPasses( Passes, *FPasses, TM, 3, 0 );
-            OptLevelO3 = false;
+        if( P == nullptr ) {
+            *errorMessage = LLVMCreateMessage( ( "Unknown or unsupported pass: '" + passName + "'" ).str( ).c_str( ) );
+            return true;
         }
 
-        const PassInfo *PassInf = PassList[ i ];
-        Pass *P = nullptr;
-        if( PassInf->getTargetMachineCtor( ) )
-            P = PassInf->getTargetMachineCtor( )( TM );
-        else if( PassInf->getNormalCtor( ) )
-            P = PassInf->getNormalCtor( )( );
-
-        if( P ) {
-            PassKind Kind = P->getPassKind( );
-            Passes.add( P );
-        }
+        Passes.add( P );
     }
 
-    if( StandardLinkOpts ) {
-        AddStandardLinkPasses( Passes );
-        StandardLinkOpts = false;
+    if( FPasses && Opts.WorkerCount > 1 ) {
+        // Each worker builds its own function pass manager (and target machine) for the
+        // functions of its partition, the module passes are only run on the whole module.
+        bool succeeded = RunOnFunctionPartitions( *M, Opts.WorkerCount, [ & ]( Module& partition ) {
+            std::unique_ptr<TargetMachine> WorkerTM = TM ? CloneTargetMachine( *TM ) : nullptr;
+            legacy::FunctionPassManager WorkerFPasses( &partition );
+            WorkerFPasses.add( createTargetTransformInfoWrapperPass(
+                WorkerTM ? WorkerTM->getTargetIRAnalysis( ) : TargetIRAnalysis( ) ) );
+
+            legacy::PassManager UnusedModulePasses;
+            for( StandardPipeline const* pipeline : FPassesPipelines )
+                AddOptimizationPasses( UnusedModulePasses, WorkerFPasses, WorkerTM.get( ), pipeline->OptLevel, pipeline->SizeLevel, Opts );
+
+            WorkerFPasses.doInitialization( );
+            for( Function &F : partition )
+                WorkerFPasses.run( F );
+            WorkerFPasses.doFinalization( );
+            return true;
+        } );
+
+        if( !succeeded ) {
+            *errorMessage = LLVMCreateMessage( "Failed to merge the optimized function partitions" );
+            return true;
+        }
     }
-
-    if( OptLevelO1 )
-        AddOptimizationPasses( Passes, *FPasses, TM, 1, 0 );
-
-    if( OptLevelO2 )
-        AddOptimizationPasses( Passes, *FPasses, TM, 2, 0 );
-
-    if( OptLevelOs )
-        AddOptimizationPasses( Passes, *FPasses, TM, 2, 1 );
-
-    if( OptLevelOz )
-        AddOptimizationPasses( Passes, *FPasses, TM, 2, 2 );
-
-    if( OptLevelO3 )
-        AddOptimizationPasses( Passes, *FPasses, TM, 3, 0 );
-
-    if( FPasses ) {
+    else if( FPasses ) {
         FPasses->doInitialization( );
         for( Function &F : *M )
             FPasses->run( F );
         FPasses->doFinalization( );
     }
 
-    // In run twice mode, we want to make sure the output is bit-by-bit
-    // equivalent if we run the pass manager again, so setup two buffers and
-    // a stream to write to them. Note that llc does something similar and it
-    // may be worth to abstract this out in the future.
-    SmallVector<char, 0> Buffer;
-    SmallVector<char, 0> CompileTwiceBuffer;
-    std::unique_ptr<raw_svector_ostream> BOS;
-    raw_ostream *OS = nullptr;
-
     // Now that we have all of the passes ready, run them.
     Passes.run( *M );
+    return false;
 }
@@ -3,6 +3,45 @@
 #include "llvm-c\Core.h"
 #include "llvm-c\TargetMachine.h"
 
+/// \brief Options for a single call to LLVMRunLegacyOptimizerWithOptions
+///
+/// These are the per call equivalents of the opt tool command line options that
+/// LLVMRunLegacyOptimizer reads from the global command line state. Use
+/// LLVMInitializeLegacyOptimizerOptions to set the defaults.
+typedef struct LLVMLegacyOptimizerOptions
+{
+    // Comma separated list of legacy pass names (e.g. "instcombine,gvn") run in order. The
+    // names "O1", "O2", "O3", "Os", "Oz" and "std-link-opts" add the corresponding standard
+    // pipeline at that point of the list, the same as the equivalent opt options.
+    char const* Passes;
+    LLVMBool DisableUnitAtATime;
+    LLVMBool DisableLoopUnrolling;
+    LLVMBool DisableLoopVectorization;
+    LLVMBool DisableSLPVectorization;
+    LLVMBool DisableSimplifyLibCalls;
+    LLVMBool EnableCoroutines;
+    LLVMBool DiscardValueNames;
+    LLVMBool PassRemarksWithHotness;
+
+    // When greater than 1, the function passes of the standard pipelines are run across this
+    // many worker threads, each with its own FunctionPassManager and a private copy of the
+    // functions it optimizes. The results are deterministic, but any function references
+    // held for the module are invalidated.
+    unsigned WorkerCount;
+} LLVMLegacyOptimizerOptions;
 
 void LLVMInitializePassesForLegacyOpt( );
+void LLVMInitializeLegacyOptimizerOptions( LLVMLegacyOptimizerOptions* options );
+
+// uses the options parsed from the command line (see LLVMParseCommandLineOptions)
 void LLVMRunLegacyOptimizer( LLVMModuleRef Mref, LLVMTargetMachineRef TMref );
+
+// Does not read or modify any global option state so it is safe to call concurrently
+// for modules in different contexts. Returns true, and sets errorMessage, if the
+// Passes list contains an unknown pass name or the parallel function passes fail.
+LLVMBool LLVMRunLegacyOptimizerWithOptions( LLVMModuleRef Mref
+                                          , LLVMTargetMachineRef TMref
+                                          , LLVMLegacyOptimizerOptions const* options
+                                          , char** errorMessage
+                                          );
+
@@ -0,0 +1,277 @@
+#include "LinkerBindings.h"
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/DebugInfo.h>
+#include <llvm/IR/DebugInfoMetadata.h>
+#include <llvm/IR/DiagnosticInfo.h>
+#include <llvm/IR/DiagnosticPrinter.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Mutex.h>
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/raw_ostream.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+namespace
+{
+    // collects the error diagnostics (i.e. from the linker) of all the private contexts
+    class LinkDiagnostics
+    {
+    public:
+        static void Handler( DiagnosticInfo const& info, void* context )
+        {
+            if( info.getSeverity( ) != DS_Error )
+                return;
+
+            std::string message;
+            raw_string_ostream stream( message );
+            DiagnosticPrinterRawOStream printer( stream );
+            info.print( printer );
+            stream.flush( );
+
+            auto self = static_cast< LinkDiagnostics* >( context );
+            sys::ScopedLock lock( self->Lock );
+            if( !self->Messages.empty( ) )
+                self->Messages += '\n';
+
+            self->Messages += message;
+        }
+
+        void Add( StringRef message )
+        {
+            sys::ScopedLock lock( Lock );
+            if( !Messages.empty( ) )
+                Messages += '\n';
+
+            Messages += message;
+        }
+
+        std::string const& GetMessages( ) const { return Messages; }
+
+    private:
+        sys::Mutex Lock;
+        std::string Messages;
+    };
+
+    // a module in a private context, the module is declared last so it is destroyed first
+    struct PrivateModule
+    {
+        std::unique_ptr<LLVMContext> Context;
+        std::unique_ptr<llvm::Module> Module;
+    };
+
+    std::unique_ptr<Module> LoadBitcode( SmallVectorImpl<char> const& bitcode, LLVMContext& context, LinkDiagnostics& diagnostics )
+    {
+        auto moduleOrErr = parseBitcodeFile( MemoryBufferRef( StringRef( bitcode.data( ), bitcode.size( ) ), "<link>" ), context );
+        if( !moduleOrErr )
+        {
+            diagnostics.Add( toString( moduleOrErr.takeError( ) ) );
+            return nullptr;
+        }
+
+        return std::move( *moduleOrErr );
+    }
+
+    void WriteBitcode( Module const& module, SmallVectorImpl<char>& bitcode )
+    {
+        raw_svector_ostream stream( bitcode );
+        WriteBitcodeToFile( &module, stream );
+    }
+
+    // Counts the identified composite debug types of a module that already have an ODR definition
+    // in context. Loading the module into context reuses those definitions instead of creating new
+    // nodes, so this is the number of types deduplicated by the load.
+    unsigned CountODRTypeMatches( Module const& module, LLVMContext& context )
+    {
+        if( !context.isODRUniquingDebugTypes( ) )
+            return 0;
+
+        DebugInfoFinder finder;
+        finder.processModule( module );
+        for( Function const& function : module )
+        {
+            for( Instruction const& instruction : instructions( function ) )
+            {
+                if( auto declare = dyn_cast<DbgDeclareInst>( &instruction ) )
+                    finder.processDeclare( module, declare );
+                else if( auto value = dyn_cast<DbgValueInst>( &instruction ) )
+                    finder.processValue( module, value );
+            }
+        }
+
+        unsigned count = 0;
+        for( DIType* type : finder.types( ) )
+        {
+            auto compositeType = dyn_cast<DICompositeType>( type );
+            if( compositeType == nullptr || compositeType->getIdentifier( ).empty( ) )
+                continue;
+
+            if( DICompositeType::getODRTypeIfExists( context, *MDString::get( context, compositeType->getIdentifier( ) ) ) != nullptr )
+                ++count;
+        }
+
+        return count;
+    }
+
+    // times a stage and appends its record
+    template<typename Fn>
+    void RunStage( std::vector<LLVMLinkStageTiming>& stages, LLVMLinkStageKind kind, unsigned level, unsigned taskCount, Fn stage )
+    {
+        auto start = std::chrono::steady_clock::now( );
+        stage( );
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now( ) - start;
+        stages.push_back( LLVMLinkStageTiming{ kind, level, taskCount, 0, elapsed.count( ) } );
+    }
+}
+
+extern "C"
+{
+    LLVMBool LLVMLinkModulesParallel( LLVMContextRef destContext
+                                    , LLVMModuleRef* modules
+                                    , unsigned moduleCount
+                                    , unsigned workerCount
+                                    , LLVMModuleRef* outModule
+                                    , LLVMLinkStageTiming* stageTimings
+                                    , unsigned stageCapacity
+                                    , unsigned* stageCount
+                                    , char** errorMessage
+                                    )
+    {
+        *outModule = nullptr;
+        *errorMessage = nullptr;
+        if( stageCount != nullptr )
+            *stageCount = 0;
+
+        if( moduleCount == 0 )
+        {
+            *errorMessage = LLVMCreateMessage( "At least one module is required" );
+            return true;
+        }
+
+        LinkDiagnostics diagnostics;
+        std::vector<LLVMLinkStageTiming> stages;
+        std::atomic<bool> failed( false );
+        ThreadPool pool( std::max( workerCount, 1u ) );
+        bool uniqueDebugTypes = unwrap( destContext )->isODRUniquingDebugTypes( );
+
+        // The modules may share a context, which is not thread safe, so they are serialized
+        // on this thread before anything runs concurrently.
+        std::vector<SmallVector<char, 0>> inputs( moduleCount );
+        RunStage( stages, LLVMLinkStageSerialize, 0, moduleCount, [ & ]
+        {
+            for( unsigned i = 0; i < moduleCount; ++i )
+                WriteBitcode( *unwrap( modules[ i ] ), inputs[ i ] );
+        } );
+
+        std::vector<PrivateModule> entries( moduleCount );
+        RunStage( stages, LLVMLinkStageLoad, 0, moduleCount, [ & ]
+        {
+            for( unsigned i = 0; i < moduleCount; ++i )
+            {
+                pool.async( [ & ]( unsigned index )
+                {
+                    PrivateModule& entry = entries[ index ];
+                    entry.Context = std::make_unique<LLVMContext>( );
+                    entry.Context->setDiagnosticHandler( LinkDiagnostics::Handler, &diagnostics );
+                    if( uniqueDebugTypes )
+                        entry.Context->enableDebugTypeODRUniquing( );
+
+                    entry.Module = LoadBitcode( inputs[ index ], *entry.Context, diagnostics );
+                    if( !entry.Module )
+                        failed = true;
+
+                    // moving out the bitcode releases it once the scope ends, limiting the peak memory use
+                    SmallVector<char, 0> loaded( std::move( inputs[ index ] ) );
+                }, i );
+            }
+
+            pool.wait( );
+        } );
+
+        // each level links entry[i+1] into entry[i] for every even i, so the relative order of
+        // the modules (and thus the link result) is the same as a serial link.
+        for( unsigned level = 0; entries.size( ) > 1 && !failed; ++level )
+        {
+            unsigned pairCount = static_cast< unsigned >( entries.size( ) / 2 );
+            std::atomic<unsigned> deduplicatedTypes( 0 );
+            RunStage( stages, LLVMLinkStageMerge, level, pairCount, [ & ]
+            {
+                for( unsigned i = 0; i < pairCount; ++i )
+                {
+                    pool.async( [ & ]( unsigned pair )
+                    {
+                        PrivateModule& dest = entries[ pair * 2 ];
+                        PrivateModule& src = entries[ pair * 2 + 1 ];
+
+                        // the source must be moved into the destination context to link it
+                        deduplicatedTypes += CountODRTypeMatches( *src.Module, *dest.Context );
+                        SmallVector<char, 0> bitcode;
+                        WriteBitcode( *src.Module, bitcode );
+                        src.Module.reset( );
+                        src.Context.reset( );
+
+                        auto srcModule = LoadBitcode( bitcode, *dest.Context, diagnostics );
+                        if( !srcModule || Linker::linkModules( *dest.Module, std::move( srcModule ) ) )
+                            failed = true;
+                    }, i );
+                }
+
+                pool.wait( );
+            } );
+
+            stages.back( ).DeduplicatedTypeCount = deduplicatedTypes;
+            std::vector<PrivateModule> next;
+            for( size_t i = 0; i < entries.size( ); i += 2 )
+                next.push_back( std::move( entries[ i ] ) );
+
+            entries = std::move( next );
+        }
+
+        if( !failed )
+        {
+            unsigned deduplicatedTypes = 0;
+            RunStage( stages, LLVMLinkStageFinalize, 0, 1, [ & ]
+            {
+                deduplicatedTypes = CountODRTypeMatches( *entries[ 0 ].Module, *unwrap( destContext ) );
+                SmallVector<char, 0> bitcode;
+                WriteBitcode( *entries[ 0 ].Module, bitcode );
+                entries.clear( );
+
+                std::unique_ptr<Module> result = LoadBitcode( bitcode, *unwrap( destContext ), diagnostics );
+                if( result )
+                    *outModule = wrap( result.release( ) );
+                else
+                    failed = true;
+            } );
+
+            stages.back( ).DeduplicatedTypeCount = deduplicatedTypes;
+        }
+
+        if( stageCount != nullptr )
+            *stageCount = static_cast< unsigned >( stages.size( ) );
+
+        if( stageTimings != nullptr )
+            std::copy_n( stages.begin( ), std::min<size_t>( stages.size( ), stageCapacity ), stageTimings );
+
+        if( failed )
+        {
+            std::string const& messages = diagnostics.GetMessages( );
+            *errorMessage = LLVMCreateMessage( messages.empty( ) ? "Module link error" : messages.c_str( ) );
+            return true;
+        }
+
+        return false;
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef _LINKER_BINDINGS_H_
+#define _LINKER_BINDINGS_H_
+
+#include <llvm-c/Core.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    enum LLVMLinkStageKind
+    {
+        LLVMLinkStageSerialize, // writing the input modules to bitcode
+        LLVMLinkStageLoad,      // loading each input into a private context
+        LLVMLinkStageMerge,     // one level of the merge tree
+        LLVMLinkStageFinalize   // moving the linked result into the destination context
+    };
+
+    typedef struct LLVMLinkStageTiming
+    {
+        LLVMLinkStageKind Kind;
+        unsigned Level;         // merge tree level (0 based) for LLVMLinkStageMerge, 0 otherwise
+        unsigned TaskCount;     // number of modules loaded or pairs merged in the stage
+        unsigned DeduplicatedTypeCount; // composite debug types that reused an existing ODR definition (merge and finalize stages)
+        double WallTimeInSeconds;
+    } LLVMLinkStageTiming;
+
+    // Links a set of modules into a single new module in destContext using a binary merge tree.
+    // Each input is loaded into a private context, then every level of the tree links pairs of
+    // modules concurrently on up to workerCount threads, until a single module remains. The
+    // input modules are not modified and remain owned by the caller. The order of the merges is
+    // fixed, so the result is deterministic for a given set of inputs, but it follows the merge
+    // tree rather than the order of the inputs. In particular, conflicting local symbols are
+    // renamed in merge tree order, so their names can differ from linking the modules, in order,
+    // into the first one.
+    //
+    // If destContext is ODR uniquing debug types (see LLVMContextSetODRUniquingDebugTypes) so are
+    // the private contexts, thus composite types shared by the modules appear once in the result.
+    //
+    // If stageTimings is not null, it receives at most stageCapacity stage records and stageCount
+    // receives the total number of stages.
+    // Returns true on failure.
+    // use: LLVMDisposeMessage() on errorMessage
+    LLVMBool LLVMLinkModulesParallel( LLVMContextRef destContext
+                                    , LLVMModuleRef* modules
+                                    , unsigned moduleCount
+                                    , unsigned workerCount
+                                    , LLVMModuleRef* outModule
+                                    , LLVMLinkStageTiming* stageTimings
+                                    , unsigned stageCapacity
+                                    , unsigned* stageCount
+                                    , char** errorMessage
+                                    );
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,29 @@
+#include "MemoryBufferBindings.h"
+#include <llvm/Support/ErrorOr.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+using namespace llvm;
+
+extern "C"
+{
+    LLVMBool LLVMCreateMemoryBufferWithMappedFile( char const* path, LLVMMemoryBufferRef* outBuffer, char** errorMessage )
+    {
+        *outBuffer = nullptr;
+        *errorMessage = nullptr;
+
+        ErrorOr<std::unique_ptr<MemoryBuffer>> bufferOrErr = MemoryBuffer::getFile( path, -1, /*RequiresNullTerminator*/ false );
+        if( std::error_code ec = bufferOrErr.getError( ) )
+        {
+            *errorMessage = LLVMCreateMessage( ec.message( ).c_str( ) );
+            return true;
+        }
+
+        *outBuffer = wrap( bufferOrErr.get( ).release( ) );
+        return false;
+    }
+
+    LLVMBool LLVMMemoryBufferIsMemoryMapped( LLVMMemoryBufferRef buffer )
+    {
+        return unwrap( buffer )->getBufferKind( ) == MemoryBuffer::MemoryBuffer_MMap;
+    }
+}
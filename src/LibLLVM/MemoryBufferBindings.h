@@ -0,0 +1,23 @@
+#ifndef _MEMORY_BUFFER_BINDINGS_H_
+#define _MEMORY_BUFFER_BINDINGS_H_
+
+#include "llvm-c/Core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    // Creates a read-only buffer for the contents of a file. Unlike
+    // LLVMCreateMemoryBufferWithContentsOfFile() the buffer doesn't require a null terminator,
+    // so files large enough to benefit from it are memory mapped instead of read into a heap
+    // allocation. Bitcode and object files are parsed directly from the mapping.
+    // Returns true on failure.
+    // use: LLVMDisposeMessage() on errorMessage
+    LLVMBool LLVMCreateMemoryBufferWithMappedFile( char const* path, LLVMMemoryBufferRef* outBuffer, char** errorMessage );
+
+    // Returns true if the buffer's contents are memory mapped from a file
+    LLVMBool LLVMMemoryBufferIsMemoryMapped( LLVMMemoryBufferRef buffer );
+#ifdef __cplusplus
+}
+#endif
+
+#endif
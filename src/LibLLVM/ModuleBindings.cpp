@@ -1,12 +1,67 @@
 #include <type_traits>
+#include <llvm/IR/DebugInfo.h>
 #include <llvm/IR/Module.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <algorithm>
 #include "ModuleBindings.h"
 #include "IRBindings.h"
+#include "StringResults.h"
 
 using namespace llvm;
 
 DEFINE_SIMPLE_CONVERSION_FUNCTIONS( NamedMDNode, LLVMNamedMDNodeRef )
 
+namespace
+{
+    constexpr size_t DefaultChunkSize = 64 * 1024;
+
+    // unbuffered stream that forwards everything written to it to a callback in chunks
+    class CallbackOStream
+        : public raw_ostream
+    {
+    public:
+        CallbackOStream( LLVMBitcodeWriteCallback callback, void* userData, size_t chunkSize )
+            : raw_ostream( /*unbuffered*/ true )
+            , Callback( callback )
+            , UserData( userData )
+            , ChunkSize( chunkSize == 0 ? DefaultChunkSize : chunkSize )
+            , Position( 0 )
+            , Aborted( false )
+        {
+        }
+
+        bool IsAborted( ) const { return Aborted; }
+
+    private:
+        void write_impl( const char* ptr, size_t size ) override
+        {
+            while( size > 0 && !Aborted )
+            {
+                size_t chunk = std::min( size, ChunkSize );
+                Aborted = !Callback( UserData, ptr, chunk );
+                Position += chunk;
+                ptr += chunk;
+                size -= chunk;
+            }
+        }
+
+        uint64_t current_pos( ) const override
+        {
+            return Position;
+        }
+
+        LLVMBitcodeWriteCallback Callback;
+        void* UserData;
+        size_t ChunkSize;
+        uint64_t Position;
+        bool Aborted;
+    };
+}
+
 extern "C"
 {
     void LLVMAddModuleFlag( LLVMModuleRef M
@@ -34,10 +89,10 @@ extern "C"
         return wrap( pModule->getOrInsertFunction( name, pSignature ) );
     }
 
-    char const* LLVMGetModuleName( LLVMModuleRef module )
+    char const* LLVMGetModuleName( LLVMModuleRef module, size_t* length )
     {
         auto pModule = unwrap( module );
-        return pModule->getModuleIdentifier( ).c_str( );
+        return BorrowString( pModule->getModuleIdentifier( ), length );
     }
 
     LLVMValueRef LLVMGetGlobalAlias( LLVMModuleRef module, char const* name )
@@ -116,9 +171,75 @@ extern "C"
         comdat.setSelectionKind( ( Comdat::SelectionKind )kind );
     }
 
-    char const* LLVMComdatGetName( LLVMComdatRef comdatRef )
+    char const* LLVMComdatGetName( LLVMComdatRef comdatRef, size_t* length )
     {
         Comdat const& comdat = *unwrap( comdatRef );
-        return LLVMCreateMessage( comdat.getName( ).str( ).c_str( ) );
+        return BorrowString( comdat.getName( ), length );
+    }
+
+    LLVMBool LLVMGetLazyBitcodeModuleInContextEx( LLVMContextRef context
+                                                , LLVMMemoryBufferRef MemBuf
+                                                , LLVMBool lazyLoadMetadata
+                                                , LLVMModuleRef* outModule
+                                                , char** errorMessage
+                                                )
+    {
+        *outModule = nullptr;
+        *errorMessage = nullptr;
+
+        // the buffer is only moved into the module on success
+        std::unique_ptr<MemoryBuffer> owner( unwrap( MemBuf ) );
+        Expected<std::unique_ptr<Module>> moduleOrErr = getOwningLazyBitcodeModule( std::move( owner ), *unwrap( context ), !!lazyLoadMetadata );
+        owner.release( );
+
+        if( !moduleOrErr )
+        {
+            *errorMessage = LLVMCreateMessage( toString( moduleOrErr.takeError( ) ).c_str( ) );
+            return true;
+        }
+
+        *outModule = wrap( moduleOrErr->release( ) );
+        return false;
+    }
+
+    LLVMBool LLVMGlobalValueIsMaterializable( LLVMValueRef globalValue )
+    {
+        return unwrap<GlobalValue>( globalValue )->isMaterializable( );
+    }
+
+    LLVMBool LLVMGlobalValueMaterialize( LLVMValueRef globalValue, char** errorMessage )
+    {
+        *errorMessage = nullptr;
+        if( Error err = unwrap<GlobalValue>( globalValue )->materialize( ) )
+        {
+            *errorMessage = LLVMCreateMessage( toString( std::move( err ) ).c_str( ) );
+            return true;
+        }
+
+        return false;
+    }
+
+    LLVMBool LLVMModuleMaterializeAll( LLVMModuleRef module, char** errorMessage )
+    {
+        *errorMessage = nullptr;
+        if( Error err = unwrap( module )->materializeAll( ) )
+        {
+            *errorMessage = LLVMCreateMessage( toString( std::move( err ) ).c_str( ) );
+            return true;
+        }
+
+        return false;
+    }
+
+    LLVMBool LLVMStripModuleDebugInfo( LLVMModuleRef module )
+    {
+        return StripDebugInfo( *unwrap( module ) );
+    }
+
+    LLVMBool LLVMWriteBitcodeToCallback( LLVMModuleRef module, LLVMBitcodeWriteCallback callback, void* userData, size_t chunkSize )
+    {
+        CallbackOStream stream( callback, userData, chunkSize );
+        WriteBitcodeToFile( unwrap( module ), stream );
+        return stream.IsAborted( );
     }
-}
\ No newline at end of file
+}
@@ -48,7 +48,8 @@ extern "C" {
                                     );
 
     LLVMValueRef LLVMGetOrInsertFunction( LLVMModuleRef module, const char* name, LLVMTypeRef functionType );
-    char const* LLVMGetModuleName( LLVMModuleRef module );
+    // The name is owned by the module and remains valid until it is renamed or disposed
+    char const* LLVMGetModuleName( LLVMModuleRef module, size_t* length );
     LLVMValueRef LLVMGetGlobalAlias( LLVMModuleRef module, char const* name );
 
     LLVMNamedMDNodeRef LLVMModuleGetModuleFlagsMetadata( LLVMModuleRef module );
@@ -71,7 +72,42 @@ extern "C" {
     // Comdat accessors
     LLVMComdatSelectionKind LLVMComdatGetKind( LLVMComdatRef comdatRef );
     void LLVMComdatSetKind( LLVMComdatRef comdatRef, LLVMComdatSelectionKind kind );
-    char const* LLVMComdatGetName( LLVMComdatRef comdatRef );
+    // returns the name (not terminated) owned by the comdat, it must not be disposed
+    char const* LLVMComdatGetName( LLVMComdatRef comdatRef, size_t* length );
+
+    // Lazy loading of bitcode, function bodies are only parsed when materialized, either
+    // individually with LLVMGlobalValueMaterialize() or all at once with LLVMModuleMaterializeAll().
+    // If lazyLoadMetadata is set, function level metadata is also loaded on demand.
+    // Takes ownership of MemBuf if (and only if) the module was read successfully.
+    // Returns true on failure.
+    // use: LLVMDisposeMessage() on errorMessage
+    LLVMBool LLVMGetLazyBitcodeModuleInContextEx( LLVMContextRef context
+                                                , LLVMMemoryBufferRef MemBuf
+                                                , LLVMBool lazyLoadMetadata
+                                                , LLVMModuleRef* outModule
+                                                , char** errorMessage
+                                                );
+
+    LLVMBool LLVMGlobalValueIsMaterializable( LLVMValueRef globalValue );
+
+    // Returns true on failure.
+    // use: LLVMDisposeMessage() on errorMessage
+    LLVMBool LLVMGlobalValueMaterialize( LLVMValueRef globalValue, char** errorMessage );
+    LLVMBool LLVMModuleMaterializeAll( LLVMModuleRef module, char** errorMessage );
+
+    // Removes all debug information (intrinsics, locations, and the metadata reachable only
+    // from them) from a module. For a lazily loaded module the functions not yet materialized
+    // are stripped as they are materialized. Returns true if the module was modified.
+    LLVMBool LLVMStripModuleDebugInfo( LLVMModuleRef module );
+
+    // Streams the bitcode for a module to a callback in chunks of at most chunkSize bytes
+    // (0 selects a default size). The data pointer is only valid for the duration of the
+    // call. If the callback returns false, no further chunks are delivered and this
+    // returns true to indicate the failure. This avoids copying the bitcode into a
+    // MemoryBuffer, but the writer still builds the complete bitcode in an internal buffer
+    // first, so the peak memory use is the same as writing to a buffer.
+    typedef LLVMBool( *LLVMBitcodeWriteCallback )( void* userData, char const* data, size_t size );
+    LLVMBool LLVMWriteBitcodeToCallback( LLVMModuleRef module, LLVMBitcodeWriteCallback callback, void* userData, size_t chunkSize );
 
 #ifdef __cplusplus
 }
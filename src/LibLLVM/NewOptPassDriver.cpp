@@ -14,6 +14,8 @@
 //===----------------------------------------------------------------------===//
 
 #include "NewOptPassDriver.h"
+#include "FunctionPartitioning.h"
+#include "TargetMachineBindings.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/CGSCCPassManager.h"
@@ -26,10 +28,14 @@
 #include "llvm/IR/PassManager.h"
 #include "llvm/IR/Verifier.h"
 #include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/CBindingWrapping.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Target/TargetMachine.h"
+#include <chrono>
+#include <memory>
+#include <vector>
 
 using namespace llvm;
 
@@ -51,6 +57,282 @@ AAPipeline( "aa-pipeline",
         "pipeline for handling managed aliasing queries" ),
     cl::Hidden );
 
+namespace
+{
+    // Holds the PassBuilder, analysis managers and parsed pass pipeline so that
+    // they are constructed only once and reused across many modules. Analysis
+    // results cached for one module are cleared after each run so nothing leaks
+    // into the next module. Instances are NOT thread safe, each thread requires
+    // its own pipeline.
+    class PassPipeline
+    {
+    public:
+        PassPipeline( TargetMachine* TM )
+            : PB( TM )
+            , LAM( DebugPM )
+            , FAM( DebugPM )
+            , CGAM( DebugPM )
+            , MAM( DebugPM )
+            , MPM( DebugPM )
+        {
+        }
+
+        // When instrument is true, each top level element of the pipeline is parsed into its own
+        // stage so that it is timed individually. Groups, such as "function(...)", and aliases,
+        // such as "default<O2>", are a single element, so they are timed as a whole.
+        bool Initialize( char const* passPipeline, LLVMOptVerifierKind VK, bool instrument = false )
+        {
+            // Specially handle the alias analysis manager so that we can register
+            // a custom pipeline of AA passes with it.
+            AAManager AA;
+            if( !PB.parseAAPipeline( AA, AAPipeline ) )
+            {
+                return false;
+            }
+
+            // Register the AA manager first so that our version is the one used.
+            FAM.registerPass( [ & ] { return std::move( AA ); } );
+
+            // Register all the basic analyses with the managers.
+            PB.registerModuleAnalyses( MAM );
+            PB.registerCGSCCAnalyses( CGAM );
+            PB.registerFunctionAnalyses( FAM );
+            PB.registerLoopAnalyses( LAM );
+            PB.crossRegisterProxies( LAM, FAM, CGAM, MAM );
+
+            if( instrument )
+            {
+                return InitializeStages( passPipeline, VK );
+            }
+
+            if( VK > LLVMOptVerifierKindNone )
+            {
+                MPM.addPass( VerifierPass( ) );
+            }
+
+            if( !PB.parsePassPipeline( MPM, passPipeline, VK == LLVMOptVerifierKindVerifyEachPass, DebugPM ) )
+            {
+                return false;
+            }
+
+            if( VK > LLVMOptVerifierKindNone )
+                MPM.addPass( VerifierPass( ) );
+
+            return true;
+        }
+
+        void Run( Module& M )
+        {
+            if( Stages.empty( ) )
+            {
+                MPM.run( M, MAM );
+            }
+            else
+            {
+                RunStages( M );
+            }
+
+            // drop any results cached for this module so the managers are ready
+            // for the next one.
+            LAM.clear( );
+            FAM.clear( );
+            CGAM.clear( );
+            MAM.clear( );
+        }
+
+        // returns the number of stages, fills at most capacity records
+        unsigned GetTimingRecords( LLVMPassTimingRecord* records, unsigned capacity ) const
+        {
+            if( records != nullptr )
+            {
+                for( unsigned i = 0; i < Stages.size( ) && i < capacity; ++i )
+                {
+                    records[ i ] = Stages[ i ]->Record;
+                }
+            }
+
+            return static_cast< unsigned >( Stages.size( ) );
+        }
+
+        void ResetTiming( )
+        {
+            for( auto& stage : Stages )
+            {
+                stage->ResetRecord( );
+            }
+        }
+
+    private:
+        struct Stage
+        {
+            Stage( std::string name )
+                : Name( std::move( name ) )
+                , MPM( DebugPM )
+            {
+                ResetRecord( );
+            }
+
+            void ResetRecord( )
+            {
+                Record = LLVMPassTimingRecord{ Name.c_str( ), 0.0, 0, 0 };
+            }
+
+            std::string Name;
+            ModulePassManager MPM;
+            LLVMPassTimingRecord Record;
+        };
+
+        bool InitializeStages( char const* passPipeline, LLVMOptVerifierKind VK )
+        {
+            // The elements are parsed individually, which accepts pipelines the parser rejects as
+            // a whole (e.g. a module pass followed by a function pass), so the whole text is
+            // validated first.
+            ModulePassManager validationPasses( DebugPM );
+            if( !PB.parsePassPipeline( validationPasses, passPipeline, false, DebugPM ) )
+            {
+                return false;
+            }
+
+            std::vector<std::string> elements = SplitPipeline( passPipeline );
+            if( elements.empty( ) )
+            {
+                return false;
+            }
+
+            if( VK > LLVMOptVerifierKindNone )
+            {
+                Stages.push_back( std::make_unique<Stage>( "verify" ) );
+                Stages.back( )->MPM.addPass( VerifierPass( ) );
+            }
+
+            for( auto& element : elements )
+            {
+                Stages.push_back( std::make_unique<Stage>( element ) );
+                if( !PB.parsePassPipeline( Stages.back( )->MPM, element, VK == LLVMOptVerifierKindVerifyEachPass, DebugPM ) )
+                {
+                    Stages.clear( );
+                    return false;
+                }
+            }
+
+            if( VK > LLVMOptVerifierKindNone )
+            {
+                Stages.push_back( std::make_unique<Stage>( "verify" ) );
+                Stages.back( )->MPM.addPass( VerifierPass( ) );
+            }
+
+            return true;
+        }
+
+        void RunStages( Module& M )
+        {
+            uint64_t instructionCount = CountInstructions( M );
+            for( auto& stage : Stages )
+            {
+                auto start = std::chrono::steady_clock::now( );
+                stage->MPM.run( M, MAM );
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now( ) - start;
+
+                LLVMPassTimingRecord& record = stage->Record;
+                record.WallTimeInSeconds += elapsed.count( );
+                record.InstructionCountBefore = instructionCount;
+                instructionCount = CountInstructions( M );
+                record.InstructionCountAfter = instructionCount;
+            }
+        }
+
+        static uint64_t CountInstructions( Module const& M )
+        {
+            uint64_t count = 0;
+            for( auto& function : M )
+            {
+                for( auto& block : function )
+                {
+                    count += block.size( );
+                }
+            }
+
+            return count;
+        }
+
+        // splits a textual pipeline at the top level commas. The parser wraps a pipeline that
+        // starts with a CGSCC or function pass in a single adaptor for all of its passes, so
+        // such a pipeline is kept as one element, as splitting it would change how the passes
+        // are run.
+        std::vector<std::string> SplitPipeline( StringRef pipeline )
+        {
+            std::vector<std::string> retVal;
+            std::vector<StringRef> elements = SplitTopLevel( pipeline );
+            if( elements.empty( ) )
+            {
+                return retVal;
+            }
+
+            ModulePassManager modulePasses( DebugPM );
+            if( !PB.parsePassPipeline( modulePasses, ( "module(" + elements.front( ) + ")" ).str( ), false, DebugPM ) )
+            {
+                retVal.push_back( pipeline.trim( ).str( ) );
+                return retVal;
+            }
+
+            for( StringRef element : elements )
+            {
+                retVal.push_back( element.str( ) );
+            }
+
+            return retVal;
+        }
+
+        static std::vector<StringRef> SplitTopLevel( StringRef text )
+        {
+            std::vector<StringRef> retVal;
+            int depth = 0;
+            size_t start = 0;
+            for( size_t i = 0; i < text.size( ); ++i )
+            {
+                switch( text[ i ] )
+                {
+                case '(':
+                    ++depth;
+                    break;
+
+                case ')':
+                    --depth;
+                    break;
+
+                case ',':
+                    if( depth == 0 )
+                    {
+                        retVal.push_back( text.slice( start, i ).trim( ) );
+                        start = i + 1;
+                    }
+                    break;
+                }
+            }
+
+            StringRef last = text.drop_front( start ).trim( );
+            if( !last.empty( ) || !retVal.empty( ) )
+            {
+                retVal.push_back( last );
+            }
+
+            return retVal;
+        }
+
+        PassBuilder PB;
+        LoopAnalysisManager LAM;
+        FunctionAnalysisManager FAM;
+        CGSCCAnalysisManager CGAM;
+        ModuleAnalysisManager MAM;
+        ModulePassManager MPM;
+
+        // only used for instrumented pipelines
+        std::vector<std::unique_ptr<Stage>> Stages;
+    };
+}
+
+DEFINE_SIMPLE_CONVERSION_FUNCTIONS( PassPipeline, LLVMPassPipelineRef )
+
 LLVMBool LLVMRunPassPipeline( LLVMContextRef context
                             , LLVMModuleRef M
                             , LLVMTargetMachineRef TM
@@ -59,48 +341,144 @@ LLVMBool LLVMRunPassPipeline( LLVMContextRef context
                             , bool ShouldPreserveAssemblyUseListOrder
                             , bool ShouldPreserveBitcodeUseListOrder
                             )
- {
-    PassBuilder PB( unwrap(TM) );
+{
+    PassPipeline pipeline( unwrap( TM ) );
+    if( !pipeline.Initialize( passPipeline, VK ) )
+    {
+        return false;
+    }
+
+    // Now that we have all of the passes ready, run them.
+    pipeline.Run( *unwrap( M ) );
+    return true;
+}
 
-    // Specially handle the alias analysis manager so that we can register
-    // a custom pipeline of AA passes with it.
-    AAManager AA;
-    if( !PB.parseAAPipeline( AA, AAPipeline ) )
+LLVMBool LLVMRunPassPipelineWithTiming( LLVMModuleRef M
+                                       , LLVMTargetMachineRef TM
+                                       , char const* passPipeline
+                                       , LLVMOptVerifierKind VK
+                                       , LLVMPassTimingCallback callback
+                                       , void* userData
+                                       )
+{
+    PassPipeline pipeline( unwrap( TM ) );
+    if( !pipeline.Initialize( passPipeline, VK, true ) )
     {
         return false;
     }
 
-    LoopAnalysisManager LAM( DebugPM );
-    FunctionAnalysisManager FAM( DebugPM );
-    CGSCCAnalysisManager CGAM( DebugPM );
-    ModuleAnalysisManager MAM( DebugPM );
+    pipeline.Run( *unwrap( M ) );
+    if( callback != nullptr )
+    {
+        std::vector<LLVMPassTimingRecord> records( pipeline.GetTimingRecords( nullptr, 0 ) );
+        pipeline.GetTimingRecords( records.data( ), static_cast< unsigned >( records.size( ) ) );
+        for( auto const& record : records )
+        {
+            callback( userData, &record );
+        }
+    }
+
+    return true;
+}
+
+LLVMPassPipelineRef LLVMCreatePassPipeline( LLVMTargetMachineRef TM
+                                          , char const* passPipeline
+                                          , LLVMOptVerifierKind VK
+                                          )
+{
+    auto pipeline = std::make_unique<PassPipeline>( unwrap( TM ) );
+    if( !pipeline->Initialize( passPipeline, VK ) )
+    {
+        return nullptr;
+    }
+
+    return wrap( pipeline.release( ) );
+}
+
+LLVMPassPipelineRef LLVMCreateInstrumentedPassPipeline( LLVMTargetMachineRef TM
+                                                      , char const* passPipeline
+                                                      , LLVMOptVerifierKind VK
+                                                      )
+{
+    auto pipeline = std::make_unique<PassPipeline>( unwrap( TM ) );
+    if( !pipeline->Initialize( passPipeline, VK, true ) )
+    {
+        return nullptr;
+    }
+
+    return wrap( pipeline.release( ) );
+}
+
+void LLVMPassPipelineRun( LLVMPassPipelineRef pipeline, LLVMModuleRef M )
+{
+    unwrap( pipeline )->Run( *unwrap( M ) );
+}
 
-    // Register the AA manager first so that our version is the one used.
-    FAM.registerPass( [ & ] { return std::move( AA ); } );
+unsigned LLVMPassPipelineGetTimingRecords( LLVMPassPipelineRef pipeline, LLVMPassTimingRecord* records, unsigned capacity )
+{
+    return unwrap( pipeline )->GetTimingRecords( records, capacity );
+}
+
+void LLVMPassPipelineResetTiming( LLVMPassPipelineRef pipeline )
+{
+    unwrap( pipeline )->ResetTiming( );
+}
+
+void LLVMDisposePassPipeline( LLVMPassPipelineRef pipeline )
+{
+    delete unwrap( pipeline );
+}
 
-    // Register all the basic analyses with the managers.
-    PB.registerModuleAnalyses( MAM );
-    PB.registerCGSCCAnalyses( CGAM );
-    PB.registerFunctionAnalyses( FAM );
-    PB.registerLoopAnalyses( LAM );
-    PB.crossRegisterProxies( LAM, FAM, CGAM, MAM );
+LLVMBool LLVMRunPassPipelineParallel( LLVMModuleRef M
+                                    , LLVMTargetMachineRef TM
+                                    , char const* modulePipeline
+                                    , char const* functionPipeline
+                                    , LLVMOptVerifierKind VK
+                                    , unsigned workerCount
+                                    )
+{
+    Module& module = *unwrap( M );
+    TargetMachine& targetMachine = *unwrap( TM );
 
-    ModulePassManager MPM( DebugPM );
-    if( VK > LLVMOptVerifierKindNone )
+    if( modulePipeline != nullptr && *modulePipeline != '\0' )
     {
-        MPM.addPass( VerifierPass( ) );
+        PassPipeline pipeline( &targetMachine );
+        if( !pipeline.Initialize( modulePipeline, VK ) )
+            return false;
+
+        pipeline.Run( module );
     }
 
-    if( !PB.parsePassPipeline( MPM, passPipeline, VK == LLVMOptVerifierKindVerifyEachPass, DebugPM ) )
+    if( functionPipeline == nullptr || *functionPipeline == '\0' )
+        return true;
+
+    std::string partitionPipeline = "function(" + std::string( functionPipeline ) + ")";
+    if( workerCount <= 1 )
     {
-        return false;
+        PassPipeline pipeline( &targetMachine );
+        if( !pipeline.Initialize( partitionPipeline.c_str( ), VK ) )
+            return false;
+
+        pipeline.Run( module );
+        return true;
     }
 
-    if( VK > LLVMOptVerifierKindNone )
-        MPM.addPass( VerifierPass( ) );
+    // validate the pipeline text once up front instead of failing in every worker
+    {
+        PassPipeline pipeline( &targetMachine );
+        if( !pipeline.Initialize( partitionPipeline.c_str( ), LLVMOptVerifierKindNone ) )
+            return false;
+    }
 
-    // Now that we have all of the passes ready, run them.
-    MPM.run( *unwrap(M), MAM );
+    // Each worker needs its own target machine and pipeline as neither is thread safe
+    return RunOnFunctionPartitions( module, workerCount, [ & ]( Module& partition )
+    {
+        auto workerTM = CloneTargetMachine( targetMachine );
+        PassPipeline pipeline( workerTM.get( ) );
+        if( !pipeline.Initialize( partitionPipeline.c_str( ), VK ) )
+            return false;
 
-    return true;
+        pipeline.Run( partition );
+        return true;
+    } );
 }
@@ -38,3 +38,94 @@ LLVMBool LLVMRunPassPipeline( LLVMContextRef context
                             , bool ShouldPreserveAssemblyUseListOrder
                             , bool ShouldPreserveBitcodeUseListOrder
                             );
+
+/// \brief Execution statistics for one stage of an instrumented pass pipeline
+///
+/// A stage is a top level element of the textual pipeline, thus timing is only as fine
+/// grained as the pipeline text. Groups and aliases are a single stage, e.g. "default<O2>"
+/// or "function(instcombine,simplifycfg)" produce one record. A pipeline that starts with a
+/// function or CGSCC pass runs all of its passes in one adaptor, so it is a single stage as
+/// well. (The PassBuilder only parses module pipelines, so the passes inside an adaptor
+/// can't be timed individually without changing the order they run in.) If verification is
+/// enabled, the verifier runs at the start and end are reported as "verify" stages.
+typedef struct LLVMPassTimingRecord
+{
+    char const* PassName;              // pipeline text for the stage, owned by the pipeline
+    double WallTimeInSeconds;          // total for all runs of the pipeline
+    uint64_t InstructionCountBefore;   // module instruction count before the last run
+    uint64_t InstructionCountAfter;    // module instruction count after the last run
+} LLVMPassTimingRecord;
+
+typedef void ( *LLVMPassTimingCallback )( void* userData, LLVMPassTimingRecord const* record );
+
+/// \brief Runs the new pass manager over a module, reporting timing for each stage of the pipeline
+///
+/// The pipeline accepts the same text as LLVMRunPassPipeline(). Once the pipeline completes, callback
+/// is called with the record for each stage, in pipeline order. The records are only valid for the
+/// duration of the callback.
+LLVMBool LLVMRunPassPipelineWithTiming( LLVMModuleRef M
+                                       , LLVMTargetMachineRef TM
+                                       , char const* passPipeline
+                                       , LLVMOptVerifierKind VK
+                                       , LLVMPassTimingCallback callback
+                                       , void* userData
+                                       );
+
+/// \brief Opaque reference to a reusable pass pipeline
+///
+/// A pass pipeline holds the PassBuilder, analysis managers and the parsed
+/// textual pipeline so they are only created once. The pipeline can then be
+/// run on any number of modules. A pipeline is not thread safe, callers
+/// optimizing modules concurrently need a pipeline per thread.
+typedef struct LLVMOpaquePassPipeline* LLVMPassPipelineRef;
+
+/// \brief Creates a reusable pass pipeline
+///
+/// Returns nullptr if either the alias analysis or pass pipeline text fails to parse.
+/// The target machine must remain valid for the lifetime of the pipeline.
+LLVMPassPipelineRef LLVMCreatePassPipeline( LLVMTargetMachineRef TM
+                                          , char const* passPipeline
+                                          , LLVMOptVerifierKind VK
+                                          );
+
+/// \brief Creates a reusable pass pipeline that records timing for each stage
+///
+/// Statistics accumulate across runs until reset with LLVMPassPipelineResetTiming().
+LLVMPassPipelineRef LLVMCreateInstrumentedPassPipeline( LLVMTargetMachineRef TM
+                                                      , char const* passPipeline
+                                                      , LLVMOptVerifierKind VK
+                                                      );
+
+/// \brief Runs a pass pipeline over a module
+void LLVMPassPipelineRun( LLVMPassPipelineRef pipeline, LLVMModuleRef M );
+
+void LLVMDisposePassPipeline( LLVMPassPipelineRef pipeline );
+
+/// \brief Retrieves the timing records of an instrumented pipeline
+///
+/// Fills at most capacity records and returns the number of stages in the pipeline, which is
+/// 0 for pipelines that are not instrumented. The PassName of each record remains valid until
+/// the pipeline is disposed.
+unsigned LLVMPassPipelineGetTimingRecords( LLVMPassPipelineRef pipeline, LLVMPassTimingRecord* records, unsigned capacity );
+
+/// \brief Resets the timing records of an instrumented pipeline
+void LLVMPassPipelineResetTiming( LLVMPassPipelineRef pipeline );
+
+/// \brief Runs the function level part of a pipeline across a pool of worker threads
+///
+/// The modulePipeline (which may be null or empty) is run serially first, so all
+/// interprocedural passes see the whole module. The functionPipeline is a textual list
+/// of function passes (e.g. "instcombine,simplifycfg"). Since an LLVMContext is not
+/// thread safe, the function definitions are partitioned across workerCount private
+/// contexts, each with its own FunctionAnalysisManager and TargetMachine. The optimized
+/// definitions are then linked back into M, replacing the originals.
+///
+/// \note Because the optimized definitions replace the originals, any function
+/// references held by the caller for M are invalidated.
+LLVMBool LLVMRunPassPipelineParallel( LLVMModuleRef M
+                                    , LLVMTargetMachineRef TM
+                                    , char const* modulePipeline
+                                    , char const* functionPipeline
+                                    , LLVMOptVerifierKind VK
+                                    , unsigned workerCount
+                                    );
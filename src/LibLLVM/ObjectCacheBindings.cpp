@@ -0,0 +1,313 @@
+#include "ObjectCacheBindings.h"
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/StringSet.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/CBindingWrapping.h>
+#include <llvm/Support/Chrono.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/SHA1.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+using namespace llvm;
+
+static TargetMachine *unwrap( LLVMTargetMachineRef P )
+{
+    return reinterpret_cast<TargetMachine *>( P );
+}
+
+namespace
+{
+    char const EntryPrefix[ ] = "llvmnet-";
+    char const EntryExtension[ ] = ".o";
+
+    class ObjectCache
+    {
+    public:
+        ObjectCache( StringRef directory, uint64_t maxSize )
+            : Directory( directory )
+            , MaxSize( maxSize )
+            , Hits( 0 )
+            , Misses( 0 )
+            , Evictions( 0 )
+            , TotalSize( 0 )
+        {
+        }
+
+        std::error_code Open( )
+        {
+            if( auto ec = sys::fs::create_directories( Directory ) )
+                return ec;
+
+            // Existing entries are seeded in the order of their last modification, after that
+            // the access order is tracked in memory.
+            std::lock_guard<std::mutex> lock( EntriesLock );
+            std::error_code ec;
+            for( sys::fs::directory_iterator it( Directory, ec ), end; it != end && !ec; it.increment( ec ) )
+            {
+                StringRef fileName = sys::path::filename( it->path( ) );
+                if( !fileName.startswith( EntryPrefix ) || !fileName.endswith( EntryExtension ) )
+                    continue;
+
+                sys::fs::file_status status;
+                if( sys::fs::status( it->path( ), status ) )
+                    continue;
+
+                Entries[ fileName ] = { status.getSize( ), status.getLastModificationTime( ) };
+                TotalSize += status.getSize( );
+            }
+
+            return ec;
+        }
+
+        std::string GetKey( Module const& module, TargetMachine const& targetMachine, StringRef passPipeline, LLVMOptVerifierKind VK )
+        {
+            SmallVector<char, 0> bitcode;
+            {
+                raw_svector_ostream bitcodeStream( bitcode );
+                WriteBitcodeToFile( &module, bitcodeStream );
+            }
+
+            // Embedded nul separators keep the individual fields from running together
+            SHA1 hasher;
+            hasher.update( ArrayRef<uint8_t>( reinterpret_cast<uint8_t const*>( bitcode.data( ) ), bitcode.size( ) ) );
+            hasher.update( StringRef( "\0", 1 ) );
+            hasher.update( targetMachine.getTargetTriple( ).str( ) );
+            hasher.update( StringRef( "\0", 1 ) );
+            hasher.update( targetMachine.getTargetCPU( ) );
+            hasher.update( StringRef( "\0", 1 ) );
+            hasher.update( targetMachine.getTargetFeatureString( ) );
+            hasher.update( StringRef( "\0", 1 ) );
+            hasher.update( passPipeline );
+            hasher.update( StringRef( "\0", 1 ) );
+            hasher.update( utostr( static_cast<unsigned>( targetMachine.getOptLevel( ) ) ) );
+
+            // the options of the target machine that affect the generated code
+            TargetOptions const& options = targetMachine.Options;
+            unsigned const codeGenOptions[ ] =
+            {
+                static_cast<unsigned>( VK ),
+                static_cast<unsigned>( targetMachine.getRelocationModel( ) ),
+                static_cast<unsigned>( targetMachine.getCodeModel( ) ),
+                options.UnsafeFPMath,
+                options.NoInfsFPMath,
+                options.NoNaNsFPMath,
+                options.NoTrappingFPMath,
+                options.NoSignedZerosFPMath,
+                options.HonorSignDependentRoundingFPMathOption,
+                options.NoZerosInBSS,
+                options.GuaranteedTailCallOpt,
+                options.StackAlignmentOverride,
+                options.EnableFastISel,
+                options.UseInitArray,
+                options.RelaxELFRelocations,
+                options.FunctionSections,
+                options.DataSections,
+                options.UniqueSectionNames,
+                options.TrapUnreachable,
+                options.EmulatedTLS,
+                options.EnableIPRA,
+                static_cast<unsigned>( options.FloatABIType ),
+                static_cast<unsigned>( options.AllowFPOpFusion ),
+                static_cast<unsigned>( options.ThreadModel ),
+                static_cast<unsigned>( options.EABIVersion ),
+                static_cast<unsigned>( options.DebuggerTuning ),
+                static_cast<unsigned>( options.ExceptionModel )
+            };
+
+            for( unsigned value : codeGenOptions )
+            {
+                hasher.update( StringRef( "\0", 1 ) );
+                hasher.update( utostr( value ) );
+            }
+
+            return EntryPrefix + toHex( hasher.final( ) ) + EntryExtension;
+        }
+
+        std::unique_ptr<MemoryBuffer> Lookup( StringRef key )
+        {
+            // The entry is read into memory (IsVolatileSize prevents mapping it), so the caller's
+            // buffer doesn't keep the file open, which would block evicting or replacing it.
+            auto buffer = MemoryBuffer::getFile( GetEntryPath( key ), -1, false, true );
+            if( !buffer )
+            {
+                ++Misses;
+                return nullptr;
+            }
+
+            ++Hits;
+            std::lock_guard<std::mutex> lock( EntriesLock );
+            auto it = Entries.find( key );
+            if( it != Entries.end( ) )
+                it->second.LastUsed = std::chrono::system_clock::now( );
+
+            return std::move( *buffer );
+        }
+
+        void Store( StringRef key, MemoryBuffer const& buffer )
+        {
+            // write to a unique temporary and rename it into place so that concurrent readers
+            // never observe a partially written entry.
+            SmallString<256> model( Directory );
+            sys::path::append( model, "llvmnet-%%%%%%%%.tmp" );
+            int fd;
+            SmallString<256> tempPath;
+            if( sys::fs::createUniqueFile( model, fd, tempPath ) )
+                return;
+
+            {
+                raw_fd_ostream os( fd, true );
+                os << buffer.getBuffer( );
+                os.close( );
+                if( os.has_error( ) )
+                {
+                    os.clear_error( );
+                    sys::fs::remove( tempPath );
+                    return;
+                }
+            }
+
+            if( sys::fs::rename( tempPath, GetEntryPath( key ) ) )
+            {
+                sys::fs::remove( tempPath );
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock( EntriesLock );
+            auto& entry = Entries[ key ];
+            TotalSize -= entry.Size;
+            entry = { buffer.getBufferSize( ), std::chrono::system_clock::now( ) };
+            TotalSize += entry.Size;
+            EvictLeastRecentlyUsed( key );
+        }
+
+        void GetStats( LLVMObjectCacheStats& stats )
+        {
+            std::lock_guard<std::mutex> lock( EntriesLock );
+            stats = { Hits, Misses, Evictions, TotalSize };
+        }
+
+    private:
+        struct Entry
+        {
+            uint64_t Size;
+            sys::TimePoint<> LastUsed;
+        };
+
+        std::string GetEntryPath( StringRef key ) const
+        {
+            SmallString<256> path( Directory );
+            sys::path::append( path, key );
+            return path.str( );
+        }
+
+        // EntriesLock must be held by the caller, the entry just stored is never evicted. An
+        // entry that can't be removed (e.g. it is in use by another process) is kept, and
+        // still counts towards the total size, so the next oldest is evicted instead.
+        void EvictLeastRecentlyUsed( StringRef keep )
+        {
+            StringSet<> failedRemovals;
+            while( MaxSize != 0 && TotalSize > MaxSize )
+            {
+                auto victim = Entries.end( );
+                for( auto it = Entries.begin( ); it != Entries.end( ); ++it )
+                {
+                    if( it->first( ) == keep || failedRemovals.count( it->first( ) ) != 0 )
+                        continue;
+
+                    if( victim == Entries.end( ) || it->second.LastUsed < victim->second.LastUsed )
+                        victim = it;
+                }
+
+                if( victim == Entries.end( ) )
+                    return;
+
+                if( sys::fs::remove( GetEntryPath( victim->first( ) ) ) )
+                {
+                    failedRemovals.insert( victim->first( ) );
+                    continue;
+                }
+
+                TotalSize -= victim->second.Size;
+                Entries.erase( victim );
+                ++Evictions;
+            }
+        }
+
+        std::string Directory;
+        uint64_t MaxSize;
+        std::atomic<uint64_t> Hits;
+        std::atomic<uint64_t> Misses;
+        uint64_t Evictions;
+        uint64_t TotalSize;
+        std::mutex EntriesLock;
+        StringMap<Entry> Entries;
+    };
+}
+
+DEFINE_SIMPLE_CONVERSION_FUNCTIONS( ObjectCache, LLVMObjectCacheRef )
+
+extern "C"
+{
+    LLVMObjectCacheRef LLVMCreateObjectCache( char const* cacheDirectory, uint64_t maxSizeInBytes, char** errorMessage )
+    {
+        auto cache = std::make_unique<ObjectCache>( cacheDirectory, maxSizeInBytes );
+        if( auto ec = cache->Open( ) )
+        {
+            *errorMessage = LLVMCreateMessage( ec.message( ).c_str( ) );
+            return nullptr;
+        }
+
+        return wrap( cache.release( ) );
+    }
+
+    void LLVMDisposeObjectCache( LLVMObjectCacheRef cache )
+    {
+        delete unwrap( cache );
+    }
+
+    LLVMBool LLVMObjectCacheCompileModule( LLVMObjectCacheRef cache
+                                           , LLVMModuleRef M
+                                           , LLVMTargetMachineRef TM
+                                           , char const* passPipeline
+                                           , LLVMOptVerifierKind VK
+                                           , LLVMMemoryBufferRef* outBuffer
+                                           , char** errorMessage
+                                           )
+    {
+        ObjectCache& objCache = *unwrap( cache );
+        StringRef pipeline = passPipeline == nullptr ? StringRef( ) : StringRef( passPipeline );
+        std::string key = objCache.GetKey( *unwrap( M ), *unwrap( TM ), pipeline, VK );
+
+        if( auto cachedBuffer = objCache.Lookup( key ) )
+        {
+            *outBuffer = wrap( cachedBuffer.release( ) );
+            return false;
+        }
+
+        if( !pipeline.empty( ) && !LLVMRunPassPipeline( LLVMGetModuleContext( M ), M, TM, passPipeline, VK, false, false ) )
+        {
+            *errorMessage = LLVMCreateMessage( "Failed to parse the pass pipeline" );
+            return true;
+        }
+
+        if( LLVMTargetMachineEmitToMemoryBuffer( TM, M, LLVMObjectFile, errorMessage, outBuffer ) )
+            return true;
+
+        objCache.Store( key, *unwrap( *outBuffer ) );
+        return false;
+    }
+
+    void LLVMObjectCacheGetStats( LLVMObjectCacheRef cache, LLVMObjectCacheStats* stats )
+    {
+        unwrap( cache )->GetStats( *stats );
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef _OBJECT_CACHE_BINDINGS_H_
+#define _OBJECT_CACHE_BINDINGS_H_
+
+#include <llvm-c/Core.h>
+#include <llvm-c/TargetMachine.h>
+#include "NewOptPassDriver.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    // Content addressed on disk cache of compiled object files. Entries are keyed on a hash of
+    // the module's bitcode combined with the target machine triple, CPU, features, relocation
+    // model, code model and code generation options, the optimization pass pipeline and the
+    // verifier kind. A cache instance is safe to share across threads.
+    typedef struct LLVMOpaqueObjectCache* LLVMObjectCacheRef;
+
+    typedef struct LLVMObjectCacheStats
+    {
+        uint64_t Hits;
+        uint64_t Misses;
+        uint64_t Evictions;
+        uint64_t SizeInBytes;
+    }LLVMObjectCacheStats;
+
+    // Creates (or opens an existing) cache in cacheDirectory, the least recently used
+    // entries are evicted whenever the total size of the cache exceeds maxSizeInBytes.
+    // A maxSizeInBytes of 0 disables eviction.
+    // use: LLVMDisposeMessage() on errorMessage
+    LLVMObjectCacheRef LLVMCreateObjectCache( char const* cacheDirectory, uint64_t maxSizeInBytes, char** errorMessage );
+    void LLVMDisposeObjectCache( LLVMObjectCacheRef cache );
+
+    // Retrieves the object code for a module from the cache, or on a miss runs passPipeline
+    // (if not null or empty) over the module, emits the object code and stores it in the
+    // cache. The module is not modified on a cache hit. The returned buffer is owned by the
+    // caller and must be released with LLVMDisposeMemoryBuffer().
+    // use: LLVMDisposeMessage() on errorMessage
+    LLVMBool LLVMObjectCacheCompileModule( LLVMObjectCacheRef cache
+                                           , LLVMModuleRef M
+                                           , LLVMTargetMachineRef TM
+                                           , char const* passPipeline
+                                           , LLVMOptVerifierKind VK
+                                           , LLVMMemoryBufferRef* outBuffer
+                                           , char** errorMessage
+                                           );
+
+    void LLVMObjectCacheGetStats( LLVMObjectCacheRef cache, LLVMObjectCacheStats* stats );
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,104 @@
+#include "OrcJitBindings.h"
+#include <llvm/ADT/Triple.h>
+#include <llvm/ExecutionEngine/RTDyldMemoryManager.h>
+#include <llvm/MC/SubtargetFeature.h>
+#include <llvm/Support/DynamicLibrary.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/TargetRegistry.h>
+#include <llvm/Target/TargetMachine.h>
+#include <cstdint>
+
+using namespace llvm;
+
+static LLVMTargetMachineRef wrap( TargetMachine const* P )
+{
+    return reinterpret_cast<LLVMTargetMachineRef>( const_cast<TargetMachine*>( P ) );
+}
+
+namespace
+{
+    // Gets the global symbol prefix of the JIT's data layout (e.g. '_' for Win32 x86),
+    // or '\0' if there isn't one, by mangling a name with it.
+    char GetGlobalPrefix( LLVMOrcJITStackRef jitStack )
+    {
+        char* mangledName = nullptr;
+        LLVMOrcGetMangledSymbol( jitStack, &mangledName, "x" );
+        char prefix = mangledName[ 1 ] == '\0' ? '\0' : mangledName[ 0 ];
+        LLVMOrcDisposeMangledSymbol( mangledName );
+        return prefix;
+    }
+
+    void* PrefixToLookupContext( char prefix )
+    {
+        return reinterpret_cast< void* >( static_cast< uintptr_t >( static_cast< unsigned char >( prefix ) ) );
+    }
+
+    // The ORC stack searches the symbols it has already JIT compiled before calling
+    // the external resolver, so this only needs to handle symbols of the host process.
+    // The lookup context holds the global prefix of the JIT's data layout.
+    uint64_t ResolveProcessSymbol( char const* name, void* lookupCtx )
+    {
+        // the process symbol lookup expects C names without the global prefix. On Darwin
+        // it strips the leading underscore itself.
+#ifndef __APPLE__
+        char prefix = static_cast< char >( reinterpret_cast< uintptr_t >( lookupCtx ) );
+        if( prefix != '\0' && name[ 0 ] == prefix )
+            ++name;
+#endif
+
+        return RTDyldMemoryManager::getSymbolAddressInProcess( name );
+    }
+}
+
+extern "C"
+{
+    LLVMOrcJITStackRef LLVMOrcCreateNativeInstance( char** errorMessage )
+    {
+        // loading the process itself makes its symbols available to ResolveProcessSymbol
+        sys::DynamicLibrary::LoadLibraryPermanently( nullptr );
+
+        std::string triple = sys::getProcessTriple( );
+        std::string error;
+        Target const* target = TargetRegistry::lookupTarget( triple, error );
+        if( target == nullptr )
+        {
+            *errorMessage = LLVMCreateMessage( error.c_str( ) );
+            return nullptr;
+        }
+
+        SubtargetFeatures features;
+        StringMap<bool> hostFeatures;
+        if( sys::getHostCPUFeatures( hostFeatures ) )
+        {
+            for( auto& feature : hostFeatures )
+                features.AddFeature( feature.first( ), feature.second );
+        }
+
+        TargetMachine* targetMachine = target->createTargetMachine( triple
+                                                                  , sys::getHostCPUName( )
+                                                                  , features.getString( )
+                                                                  , TargetOptions( )
+                                                                  , None
+                                                                  , CodeModel::JITDefault
+                                                                  , CodeGenOpt::Default
+                                                                  );
+        if( targetMachine == nullptr )
+        {
+            *errorMessage = LLVMCreateMessage( "Unable to create a target machine for the host" );
+            return nullptr;
+        }
+
+        // the JIT stack takes ownership of the target machine
+        return LLVMOrcCreateInstance( wrap( targetMachine ) );
+    }
+
+    LLVMOrcModuleHandle LLVMOrcAddLazilyCompiledModule( LLVMOrcJITStackRef jitStack, LLVMModuleRef module )
+    {
+        return LLVMOrcAddLazilyCompiledIR( jitStack, module, ResolveProcessSymbol, PrefixToLookupContext( GetGlobalPrefix( jitStack ) ) );
+    }
+
+    LLVMOrcModuleHandle LLVMOrcAddEagerlyCompiledModule( LLVMOrcJITStackRef jitStack, LLVMModuleRef module )
+    {
+        return LLVMOrcAddEagerlyCompiledIR( jitStack, module, ResolveProcessSymbol, PrefixToLookupContext( GetGlobalPrefix( jitStack ) ) );
+    }
+}
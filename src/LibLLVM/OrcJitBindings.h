@@ -0,0 +1,29 @@
+#ifndef _ORC_JIT_BINDINGS_H_
+#define _ORC_JIT_BINDINGS_H_
+
+#include <llvm-c/Core.h>
+#include <llvm-c/OrcBindings.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    // Creates an ORC JIT stack for the host process. The native target must be initialized
+    // first (see LLVMInitializeNativeTarget, LLVMInitializeNativeAsmPrinter). The target
+    // machine is created for the host CPU and features and is owned by the JIT stack.
+    // returns nullptr on failure
+    // use: LLVMDisposeMessage() on errorMessage
+    LLVMOrcJITStackRef LLVMOrcCreateNativeInstance( char** errorMessage );
+
+    // Adds a module to the JIT, the JIT takes ownership of the module. Each function is
+    // reached through an indirect stub and compiled the first time it is called. Symbols
+    // not defined in the JIT are resolved against the symbols of the host process.
+    LLVMOrcModuleHandle LLVMOrcAddLazilyCompiledModule( LLVMOrcJITStackRef jitStack, LLVMModuleRef module );
+
+    // Adds a module to the JIT and compiles all of it immediately, the JIT takes ownership
+    // of the module. Symbols are resolved in the same way as LLVMOrcAddLazilyCompiledModule.
+    LLVMOrcModuleHandle LLVMOrcAddEagerlyCompiledModule( LLVMOrcJITStackRef jitStack, LLVMModuleRef module );
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef _STRING_RESULTS_H_
+#define _STRING_RESULTS_H_
+
+#include <llvm/ADT/StringRef.h>
+#include <stddef.h>
+#include <string>
+
+// Helpers for bindings returning strings as a pointer and length, without an allocation
+// per call or a matching call to LLVMDisposeMessage().
+
+// Returns a string owned elsewhere (i.e. by an LLVM object or static data). The caller
+// must copy the string before the owner is modified or destroyed.
+inline char const* BorrowString( llvm::StringRef str, size_t* length )
+{
+    *length = str.size( );
+    return str.data( );
+}
+
+// Gets an empty per thread buffer for a string computed by a binding. A string returned
+// from the buffer, with BorrowString(), remains valid until the buffer is used again on
+// the same thread.
+inline std::string& GetThreadStringBuffer( )
+{
+    thread_local std::string buffer;
+    buffer.clear( );
+    return buffer;
+}
+
+#endif
@@ -0,0 +1,78 @@
+#include "TargetMachineBindings.h"
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/CodeGen/ParallelCG.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <vector>
+
+using namespace llvm;
+
+static TargetMachine *unwrap( LLVMTargetMachineRef P )
+{
+    return reinterpret_cast<TargetMachine *>( P );
+}
+
+std::unique_ptr<TargetMachine> CloneTargetMachine( TargetMachine const& TM )
+{
+    return std::unique_ptr<TargetMachine>( TM.getTarget( ).createTargetMachine( TM.getTargetTriple( ).str( )
+                                                                              , TM.getTargetCPU( )
+                                                                              , TM.getTargetFeatureString( )
+                                                                              , TM.Options
+                                                                              , TM.getRelocationModel( )
+                                                                              , TM.getCodeModel( )
+                                                                              , TM.getOptLevel( )
+                                                                              )
+                                         );
+}
+
+extern "C"
+{
+    LLVMBool LLVMTargetMachineEmitPartitionsToMemoryBuffers( LLVMTargetMachineRef T
+                                                           , LLVMModuleRef M
+                                                           , unsigned partitionCount
+                                                           , LLVMCodeGenFileType codegen
+                                                           , LLVMMemoryBufferRef* outBuffers
+                                                           , char** ErrorMessage
+                                                           )
+    {
+        if( partitionCount == 0 || outBuffers == nullptr )
+        {
+            *ErrorMessage = LLVMCreateMessage( "at least one output partition is required" );
+            return true;
+        }
+
+        TargetMachine& targetMachine = *unwrap( T );
+        auto fileType = codegen == LLVMAssemblyFile ? TargetMachine::CGFT_AssemblyFile : TargetMachine::CGFT_ObjectFile;
+
+        std::vector<SmallVector<char, 0>> buffers( partitionCount );
+        std::vector<std::unique_ptr<raw_svector_ostream>> streams;
+        std::vector<raw_pwrite_stream*> outputs;
+        for( auto& buffer : buffers )
+        {
+            streams.push_back( std::make_unique<raw_svector_ostream>( buffer ) );
+            outputs.push_back( streams.back( ).get( ) );
+        }
+
+        // splitCodeGen consumes the module it is given so it operates on a clone, the
+        // partitions it creates are each round tripped through bitcode into a private context
+        splitCodeGen( CloneModule( unwrap( M ) )
+                    , outputs
+                    , { }
+                    , [ & ] { return CloneTargetMachine( targetMachine ); }
+                    , fileType
+                    );
+
+        for( unsigned i = 0; i < partitionCount; ++i )
+        {
+            auto buffer = MemoryBuffer::getMemBufferCopy( StringRef( buffers[ i ].data( ), buffers[ i ].size( ) )
+                                                        , unwrap( M )->getModuleIdentifier( ) + "." + std::to_string( i )
+                                                        );
+            outBuffers[ i ] = wrap( buffer.release( ) );
+        }
+
+        return false;
+    }
+}
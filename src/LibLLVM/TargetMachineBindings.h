@@ -0,0 +1,34 @@
+#ifndef _TARGET_MACHINE_BINDINGS_H_
+#define _TARGET_MACHINE_BINDINGS_H_
+
+#include <llvm-c/Core.h>
+#include <llvm-c/TargetMachine.h>
+
+#ifdef __cplusplus
+#include <memory>
+#include <llvm/Target/TargetMachine.h>
+
+extern "C" {
+#endif
+    // Splits the module by function into partitionCount partitions and generates code for
+    // all of them in parallel, each in its own context with its own target machine. The
+    // module itself is not modified (a clone of it is split). On success, outBuffers
+    // receives partitionCount memory buffers that the caller must release with
+    // LLVMDisposeMemoryBuffer().
+    // use: LLVMDisposeMessage() on ErrorMessage
+    LLVMBool LLVMTargetMachineEmitPartitionsToMemoryBuffers( LLVMTargetMachineRef T
+                                                           , LLVMModuleRef M
+                                                           , unsigned partitionCount
+                                                           , LLVMCodeGenFileType codegen
+                                                           , LLVMMemoryBufferRef* outBuffers
+                                                           , char** ErrorMessage
+                                                           );
+#ifdef __cplusplus
+}
+
+// Target machines cache subtargets per function and are therefore not safe to share
+// across threads. This creates an equivalent instance for use on another thread.
+std::unique_ptr<llvm::TargetMachine> CloneTargetMachine( llvm::TargetMachine const& TM );
+#endif
+
+#endif
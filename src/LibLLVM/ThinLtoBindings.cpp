@@ -0,0 +1,154 @@
+#include "ThinLtoBindings.h"
+#include <llvm/ADT/StringSet.h>
+#include <llvm/Bitcode/BitcodeWriterPass.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Module.h>
+#include <llvm/LTO/legacy/ThinLTOCodeGenerator.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+namespace
+{
+    class ThinLtoCodeGen
+    {
+    public:
+        ThinLtoCodeGen( TargetMachine const& TM, unsigned optLevel )
+        {
+            CodeGen.setCpu( TM.getTargetCPU( ) );
+            CodeGen.setAttr( TM.getTargetFeatureString( ) );
+            CodeGen.setTargetOptions( TM.Options );
+            CodeGen.setCodePICModel( TM.getRelocationModel( ) );
+            CodeGen.setCodeGenOptLevel( TM.getOptLevel( ) );
+            CodeGen.setOptLevel( optLevel );
+        }
+
+        bool AddModule( Module& M, std::string& errorMessage )
+        {
+            if( M.getTargetTriple( ).empty( ) || ( !TargetTriple.empty( ) && TargetTriple != M.getTargetTriple( ) ) )
+            {
+                errorMessage = "All modules must have the same target triple: " + M.getModuleIdentifier( );
+                return false;
+            }
+
+            // the code generator only references the identifier and bitcode so both are retained here
+            auto identifier = Identifiers.insert( M.getModuleIdentifier( ) );
+            if( !identifier.second )
+            {
+                errorMessage = "Duplicate module identifier: " + M.getModuleIdentifier( );
+                return false;
+            }
+
+            TargetTriple = M.getTargetTriple( );
+            Bitcode.push_back( std::make_unique<std::string>( ) );
+            {
+                raw_string_ostream stream( *Bitcode.back( ) );
+                legacy::PassManager passes;
+                passes.add( createBitcodeWriterPass( stream, false, true /*EmitSummaryIndex*/, true /*EmitModuleHash*/ ) );
+                passes.run( M );
+            }
+
+            CodeGen.addModule( identifier.first->getKey( ), *Bitcode.back( ) );
+            return true;
+        }
+
+        void PreserveSymbol( StringRef name )
+        {
+            CodeGen.preserveSymbol( name );
+        }
+
+        bool Run( std::string& errorMessage )
+        {
+            if( Bitcode.empty( ) )
+            {
+                errorMessage = "At least one module is required";
+                return false;
+            }
+
+            CodeGen.run( );
+            return true;
+        }
+
+        std::vector<std::unique_ptr<MemoryBuffer>>& GetObjects( )
+        {
+            return CodeGen.getProducedBinaries( );
+        }
+
+    private:
+        ThinLTOCodeGenerator CodeGen;
+        StringSet<> Identifiers;
+        std::string TargetTriple;
+        std::vector<std::unique_ptr<std::string>> Bitcode;
+    };
+}
+
+DEFINE_SIMPLE_CONVERSION_FUNCTIONS( ThinLtoCodeGen, LLVMThinLtoCodeGenRef )
+
+static TargetMachine *unwrap( LLVMTargetMachineRef P )
+{
+    return reinterpret_cast<TargetMachine *>( P );
+}
+
+extern "C"
+{
+    LLVMThinLtoCodeGenRef LLVMCreateThinLtoCodeGen( LLVMTargetMachineRef TM, unsigned optLevel )
+    {
+        return wrap( new ThinLtoCodeGen( *unwrap( TM ), optLevel ) );
+    }
+
+    void LLVMDisposeThinLtoCodeGen( LLVMThinLtoCodeGenRef codeGen )
+    {
+        delete unwrap( codeGen );
+    }
+
+    LLVMBool LLVMThinLtoAddModule( LLVMThinLtoCodeGenRef codeGen, LLVMModuleRef M, char** errorMessage )
+    {
+        *errorMessage = nullptr;
+        std::string error;
+        if( !unwrap( codeGen )->AddModule( *unwrap( M ), error ) )
+        {
+            *errorMessage = LLVMCreateMessage( error.c_str( ) );
+            return true;
+        }
+
+        return false;
+    }
+
+    void LLVMThinLtoPreserveSymbol( LLVMThinLtoCodeGenRef codeGen, char const* name )
+    {
+        unwrap( codeGen )->PreserveSymbol( name );
+    }
+
+    LLVMBool LLVMThinLtoRun( LLVMThinLtoCodeGenRef codeGen, char** errorMessage )
+    {
+        *errorMessage = nullptr;
+        std::string error;
+        if( !unwrap( codeGen )->Run( error ) )
+        {
+            *errorMessage = LLVMCreateMessage( error.c_str( ) );
+            return true;
+        }
+
+        return false;
+    }
+
+    unsigned LLVMThinLtoGetObjectCount( LLVMThinLtoCodeGenRef codeGen )
+    {
+        return static_cast< unsigned >( unwrap( codeGen )->GetObjects( ).size( ) );
+    }
+
+    LLVMMemoryBufferRef LLVMThinLtoGetObject( LLVMThinLtoCodeGenRef codeGen, unsigned index )
+    {
+        auto& objects = unwrap( codeGen )->GetObjects( );
+        if( index >= objects.size( ) || !objects[ index ] )
+            return nullptr;
+
+        auto& object = *objects[ index ];
+        return wrap( MemoryBuffer::getMemBufferCopy( object.getBuffer( ), object.getBufferIdentifier( ) ).release( ) );
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef _THIN_LTO_BINDINGS_H_
+#define _THIN_LTO_BINDINGS_H_
+
+#include <llvm-c/Core.h>
+#include <llvm-c/TargetMachine.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    // Summary based (ThinLTO) link time optimization of a set of modules. Each module added is
+    // written to bitcode along with a summary of its symbols and references. Running the code
+    // generator combines the summaries into a global index, which drives the import of functions
+    // across modules, then the optimization and code generation of each module (the backends)
+    // runs concurrently on a pool of worker threads. Thus, there is no single whole program
+    // optimization step and no module ever holds the entire program.
+    typedef struct LLVMOpaqueThinLtoCodeGen* LLVMThinLtoCodeGenRef;
+
+    // Creates a code generator with the CPU, features, options, relocation model and code
+    // generation optimization level of TM. The target machine is only used during this call.
+    // optLevel (0-3) sets the optimization level of the backends.
+    LLVMThinLtoCodeGenRef LLVMCreateThinLtoCodeGen( LLVMTargetMachineRef TM, unsigned optLevel );
+    void LLVMDisposeThinLtoCodeGen( LLVMThinLtoCodeGenRef codeGen );
+
+    // Adds a module to the set to optimize. The module is serialized, along with its summary,
+    // so it is not modified or retained and may be disposed once this returns. The module
+    // identifier must be unique within the set and all modules must share the same triple.
+    // use: LLVMDisposeMessage() on errorMessage
+    LLVMBool LLVMThinLtoAddModule( LLVMThinLtoCodeGenRef codeGen, LLVMModuleRef M, char** errorMessage );
+
+    // Marks a symbol as referenced from outside the set of modules, preventing it from being
+    // internalized or removed.
+    void LLVMThinLtoPreserveSymbol( LLVMThinLtoCodeGenRef codeGen, char const* name );
+
+    // Runs the import, optimization and code generation for all the modules added.
+    // use: LLVMDisposeMessage() on errorMessage
+    LLVMBool LLVMThinLtoRun( LLVMThinLtoCodeGenRef codeGen, char** errorMessage );
+
+    // Gets the number of object files produced by the last call to LLVMThinLtoRun(), one per
+    // module added, in the order the modules were added.
+    unsigned LLVMThinLtoGetObjectCount( LLVMThinLtoCodeGenRef codeGen );
+
+    // Gets a copy of an object file produced by the last call to LLVMThinLtoRun(). The buffer
+    // is owned by the caller and must be released with LLVMDisposeMemoryBuffer().
+    LLVMMemoryBufferRef LLVMThinLtoGetObject( LLVMThinLtoCodeGenRef codeGen, unsigned index );
+#ifdef __cplusplus
+}
+#endif
+
+#endif
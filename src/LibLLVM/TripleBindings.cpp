@@ -4,6 +4,7 @@
 #include <llvm/Support/TargetParser.h>
 
 #include "TripleBindings.h"
+#include "StringResults.h"
 
 using namespace llvm;
 
@@ -127,9 +128,11 @@ ARM::ArchKind MapEnum( LLVMTripleSubArchType from )
     }
 }
 
-char const* LLVMNormalizeTriple( char const* triple )
+char const* LLVMNormalizeTriple( char const* triple, size_t* length )
 {
-    return LLVMCreateMessage( Triple::normalize( triple ).c_str( ) );
+    std::string& buffer = GetThreadStringBuffer( );
+    buffer = Triple::normalize( triple );
+    return BorrowString( buffer, length );
 }
 
 LLVMTripleRef LLVMParseTriple( char const* triple )
@@ -142,11 +145,15 @@ void LLVMDisposeTriple( LLVMTripleRef triple )
     delete unwrap( triple );
 }
 
-char const* LLVMTripleAsString( LLVMTripleRef triple, bool normalize )
+char const* LLVMTripleAsString( LLVMTripleRef triple, bool normalize, size_t* length )
 {
     Triple& llvmTriple = *unwrap( triple );
-    auto str = normalize ? llvmTriple.normalize() : llvmTriple.getTriple( );
-    return LLVMCreateMessage( str.c_str( ) );
+    if( !normalize )
+        return BorrowString( llvmTriple.getTriple( ), length );
+
+    std::string& buffer = GetThreadStringBuffer( );
+    buffer = llvmTriple.normalize( );
+    return BorrowString( buffer, length );
 }
 
 LLVMBool LLVMTripleOpEqual( LLVMTripleRef lhs, LLVMTripleRef rhs )
@@ -194,16 +201,16 @@ LLVMTripleObjectFormatType LLVMTripleGetObjectFormatType( LLVMTripleRef triple )
     return ( LLVMTripleObjectFormatType )unwrap( triple )->getObjectFormat( );
 }
 
-char const* LLVMTripleGetArchTypeName( LLVMTripleArchType type )
+char const* LLVMTripleGetArchTypeName( LLVMTripleArchType type, size_t* length )
 {
     auto llvmArchType = ( Triple::ArchType )type;
     if( llvmArchType > Triple::ArchType::LastArchType )
         llvmArchType = Triple::ArchType::UnknownArch;
 
-    return LLVMCreateMessage( Triple::getArchTypeName( llvmArchType ).data() );
+    return BorrowString( Triple::getArchTypeName( llvmArchType ), length );
 }
 
-char const* LLVMTripleGetSubArchTypeName( LLVMTripleSubArchType type )
+char const* LLVMTripleGetSubArchTypeName( LLVMTripleSubArchType type, size_t* length )
 {
     ARM::ArchKind armKind = MapEnum( type );
     if( armKind == ARM::ArchKind::AK_INVALID )
@@ -211,47 +218,47 @@ char const* LLVMTripleGetSubArchTypeName( LLVMTripleSubArchType type )
         switch( type )
         {
         case LLVMTripleSubArchType::LlvmTripleSubArchType_KalimbaSubArch_v3:
-            return LLVMCreateMessage( "kalimba3" );
+            return BorrowString( "kalimba3", length );
         case LLVMTripleSubArchType::LlvmTripleSubArchType_KalimbaSubArch_v4:
-            return LLVMCreateMessage( "kalimba4" );
+            return BorrowString( "kalimba4", length );
         case LLVMTripleSubArchType::LlvmTripleSubArchType_KalimbaSubArch_v5:
-            return LLVMCreateMessage( "kalimba5" );
+            return BorrowString( "kalimba5", length );
         default:
-            return nullptr;
+            return BorrowString( "", length );
         }
     }
 
-    return LLVMCreateMessage( ARM::getSubArch( armKind ).begin() );
+    return BorrowString( ARM::getSubArch( armKind ), length );
 }
 
-char const* LLVMTripleGetVendorTypeName( LLVMTripleVendorType vendor )
+char const* LLVMTripleGetVendorTypeName( LLVMTripleVendorType vendor, size_t* length )
 {
     auto llvmVendorType = ( Triple::VendorType )vendor;
     if( llvmVendorType > Triple::VendorType::LastVendorType )
         llvmVendorType = Triple::VendorType::UnknownVendor;
 
-    return LLVMCreateMessage( Triple::getVendorTypeName( llvmVendorType ).data() );
+    return BorrowString( Triple::getVendorTypeName( llvmVendorType ), length );
 }
 
-char const* LLVMTripleGetOsTypeName( LLVMTripleOSType osType )
+char const* LLVMTripleGetOsTypeName( LLVMTripleOSType osType, size_t* length )
 {
     auto llvmOsType = ( Triple::OSType )osType;
     if( llvmOsType > Triple::OSType::LastOSType )
         llvmOsType = Triple::OSType::UnknownOS;
 
-    return LLVMCreateMessage( Triple::getOSTypeName( llvmOsType ).data() );
+    return BorrowString( Triple::getOSTypeName( llvmOsType ), length );
 }
 
-char const* LLVMTripleGetEnvironmentTypeName( LLVMTripleEnvironmentType environmentType )
+char const* LLVMTripleGetEnvironmentTypeName( LLVMTripleEnvironmentType environmentType, size_t* length )
 {
     auto llvmEnvironmentType = ( Triple::EnvironmentType )environmentType;
     if( llvmEnvironmentType > Triple::EnvironmentType::LastEnvironmentType )
         llvmEnvironmentType = Triple::EnvironmentType::UnknownEnvironment;
 
-    return LLVMCreateMessage( Triple::getEnvironmentTypeName( llvmEnvironmentType ).data() );
+    return BorrowString( Triple::getEnvironmentTypeName( llvmEnvironmentType ), length );
 }
 
-char const* LLVMTripleGetObjectFormatTypeName( LLVMTripleObjectFormatType objectFormatType )
+char const* LLVMTripleGetObjectFormatTypeName( LLVMTripleObjectFormatType objectFormatType, size_t* length )
 {
 
     auto llvmObjectFormatType = ( Triple::ObjectFormatType )objectFormatType;
@@ -259,12 +266,12 @@ char const* LLVMTripleGetObjectFormatTypeName( LLVMTripleObjectFormatType object
     switch( llvmObjectFormatType )
     {
     case Triple::ObjectFormatType::COFF:
-        return LLVMCreateMessage( "coff" );
+        return BorrowString( "coff", length );
     case Triple::ObjectFormatType::ELF:
-        return LLVMCreateMessage( "elf" );
+        return BorrowString( "elf", length );
     case Triple::ObjectFormatType::MachO:
-        return LLVMCreateMessage( "macho" );
+        return BorrowString( "macho", length );
     default:
-        return LLVMCreateMessage( "" );
+        return BorrowString( "", length );
     }
 }
@@ -1,6 +1,7 @@
 #ifndef LLVM_TRIPLE_BINDINGS_H
 #define LLVM_TRIPLE_BINDINGS_H
 #include <llvm-c\Types.h>
+#include <stddef.h>
 
 enum LLVMTripleArchType
 {
@@ -179,14 +180,16 @@ LLVMTripleEnvironmentType LLVMTripleGetEnvironmentType( LLVMTripleRef triple );
 void LLVMTripleGetEnvironmentVersion( LLVMTripleRef triple, unsigned* major, unsigned* minor, unsigned* micro );
 LLVMTripleObjectFormatType LLVMTripleGetObjectFormatType( LLVMTripleRef triple );
 
-// Use LLVMDisposeMessage on return for all of these
-char const* LLVMTripleAsString( LLVMTripleRef triple, bool normalize );
-char const* LLVMTripleGetArchTypeName( LLVMTripleArchType type );
-char const* LLVMTripleGetArchTypeName( LLVMTripleArchType type );
-char const* LLVMTripleGetSubArchTypeName( LLVMTripleSubArchType type );
-char const* LLVMTripleGetVendorTypeName( LLVMTripleVendorType vendor );
-char const* LLVMTripleGetOsTypeName( LLVMTripleOSType osType );
-char const* LLVMTripleGetEnvironmentTypeName( LLVMTripleEnvironmentType environmentType );
-char const* LLVMTripleGetObjectFormatTypeName( LLVMTripleObjectFormatType objectFormatType );
-char const* LLVMNormalizeTriple( char const* triple );
+// These return a pointer and length for a string that is not terminated and must not be disposed.
+// The names of the triple components are static and a triple's own string remains valid until the
+// triple is disposed. Normalized strings are held in a per thread buffer and remain valid until the
+// next binding returning a computed string is called on the same thread.
+char const* LLVMTripleAsString( LLVMTripleRef triple, bool normalize, size_t* length );
+char const* LLVMTripleGetArchTypeName( LLVMTripleArchType type, size_t* length );
+char const* LLVMTripleGetSubArchTypeName( LLVMTripleSubArchType type, size_t* length );
+char const* LLVMTripleGetVendorTypeName( LLVMTripleVendorType vendor, size_t* length );
+char const* LLVMTripleGetOsTypeName( LLVMTripleOSType osType, size_t* length );
+char const* LLVMTripleGetEnvironmentTypeName( LLVMTripleEnvironmentType environmentType, size_t* length );
+char const* LLVMTripleGetObjectFormatTypeName( LLVMTripleObjectFormatType objectFormatType, size_t* length );
+char const* LLVMNormalizeTriple( char const* triple, size_t* length );
 #endif
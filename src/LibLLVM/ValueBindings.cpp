@@ -6,9 +6,58 @@
 #include <llvm\IR\GlobalObject.h>
 #include <llvm\IR\GlobalAlias.h>
 #include <llvm\IR\IRBuilder.h>
+#include <llvm\IR\InstIterator.h>
 
 using namespace llvm;
 
+namespace
+{
+    // appends the instructions of a function to infos, returns the updated instruction count
+    unsigned GetInstructionInfos( Function& function, LLVMInstructionInfo* infos, unsigned capacity, unsigned count )
+    {
+        for( Instruction& inst : instructions( function ) )
+        {
+            if( count < capacity )
+            {
+                LLVMValueRef instRef = wrap( &inst );
+                infos[ count ].Instruction = instRef;
+                infos[ count ].ValueID = inst.getValueID( );
+                infos[ count ].Opcode = LLVMGetInstructionOpcode( instRef );
+                infos[ count ].OperandCount = inst.getNumOperands( );
+            }
+
+            ++count;
+        }
+
+        return count;
+    }
+
+    // fills the CSR offsets for the values and the results up to capacity, using rangeOf(Value&) to
+    // get the range of related values for each one.
+    template<typename RangeFn>
+    unsigned GetRelatedValuesBulk( LLVMValueRef const* values, unsigned valueCount, unsigned* offsets, LLVMValueRef* results, unsigned capacity, RangeFn rangeOf )
+    {
+        if( results == nullptr )
+            capacity = 0;
+
+        unsigned count = 0;
+        for( unsigned i = 0; i < valueCount; ++i )
+        {
+            offsets[ i ] = count;
+            for( Value* related : rangeOf( *unwrap( values[ i ] ) ) )
+            {
+                if( count < capacity )
+                    results[ count ] = wrap( related );
+
+                ++count;
+            }
+        }
+
+        offsets[ valueCount ] = count;
+        return count;
+    }
+}
+
 extern "C"
 {
     LLVMComdatRef LLVMGlobalObjectGetComdat( LLVMValueRef Val )
@@ -75,4 +124,43 @@ extern "C"
         auto gv = unwrap<GlobalVariable>( globalVar );
         gv->addDebugInfo( unwrap<DIGlobalVariableExpression>( exp ));
     }
+
+    unsigned LLVMFunctionGetInstructionInfos( LLVMValueRef /*Function*/ function, LLVMInstructionInfo* infos, unsigned capacity )
+    {
+        if( infos == nullptr )
+            capacity = 0;
+
+        return GetInstructionInfos( *unwrap<Function>( function ), infos, capacity, 0 );
+    }
+
+    unsigned LLVMModuleGetInstructionInfos( LLVMModuleRef module, LLVMInstructionInfo* infos, unsigned capacity )
+    {
+        if( infos == nullptr )
+            capacity = 0;
+
+        unsigned count = 0;
+        for( Function& function : *unwrap( module ) )
+        {
+            count = GetInstructionInfos( function, infos, capacity, count );
+        }
+
+        return count;
+    }
+
+    unsigned LLVMGetOperandsBulk( LLVMValueRef const* values, unsigned valueCount, unsigned* offsets, LLVMValueRef* results, unsigned capacity )
+    {
+        return GetRelatedValuesBulk( values, valueCount, offsets, results, capacity, []( Value& value )
+        {
+            auto pUser = dyn_cast< User >( &value );
+            return pUser == nullptr ? make_range( User::value_op_iterator( ), User::value_op_iterator( ) ) : pUser->operand_values( );
+        } );
+    }
+
+    unsigned LLVMGetUsersBulk( LLVMValueRef const* values, unsigned valueCount, unsigned* offsets, LLVMValueRef* results, unsigned capacity )
+    {
+        return GetRelatedValuesBulk( values, valueCount, offsets, results, capacity, []( Value& value )
+        {
+            return value.users( );
+        } );
+    }
 }
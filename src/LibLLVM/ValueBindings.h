@@ -9,6 +9,15 @@
 extern "C" {
 #endif
 
+    /// <summary>Summary information for an instruction returned from the bulk enumeration functions</summary>
+    typedef struct LLVMInstructionInfo
+    {
+        LLVMValueRef Instruction;
+        int ValueID;            // value ID as returned from LLVMGetValueID()
+        LLVMOpcode Opcode;      // stable C API opcode as returned from LLVMGetInstructionOpcode()
+        unsigned OperandCount;
+    } LLVMInstructionInfo;
+
     LLVMBool LLVMIsConstantZeroValue( LLVMValueRef valueRef );
     void LLVMRemoveGlobalFromParent( LLVMValueRef valueRef );
 
@@ -23,6 +32,21 @@ extern "C" {
     void LLVMGlobalObjectSetComdat( LLVMValueRef Val, LLVMComdatRef comdatRef );
 
     void LLVMGlobalVariableAddDebugExpression( LLVMValueRef /*GlobalVariable*/ globalVar, LLVMMetadataRef exp );
+
+    // Fills at most capacity entries of infos, in block then instruction order, and returns the total
+    // number of instructions in the function. Call with infos==nullptr and capacity==0 to get the count.
+    unsigned LLVMFunctionGetInstructionInfos( LLVMValueRef /*Function*/ function, LLVMInstructionInfo* infos, unsigned capacity );
+
+    // same as LLVMFunctionGetInstructionInfos() but for all the functions of a module, in module order
+    unsigned LLVMModuleGetInstructionInfos( LLVMModuleRef module, LLVMInstructionInfo* infos, unsigned capacity );
+
+    // Bulk extraction of the operands or users of a set of values in compressed sparse row (CSR) form.
+    // offsets must have valueCount+1 entries and is always completely filled in. The entries for
+    // values[i] are results[offsets[i]] through results[offsets[i+1]-1]. At most capacity entries are
+    // written to results and the total number of entries is returned. Call with results==nullptr and
+    // capacity==0 to get the required size. Values that are not a User have no operands.
+    unsigned LLVMGetOperandsBulk( LLVMValueRef const* values, unsigned valueCount, unsigned* offsets, LLVMValueRef* results, unsigned capacity );
+    unsigned LLVMGetUsersBulk( LLVMValueRef const* values, unsigned valueCount, unsigned* offsets, LLVMValueRef* results, unsigned capacity );
 #ifdef __cplusplus
 }
 #endif
@@ -28,7 +28,7 @@ public string Name
                     return string.Empty;
                 }
 
-                return NativeMethods.ComdatGetName( ComdatHandle );
+                return StringMarshaler.FromBorrowedName( NativeMethods.ComdatGetName( ComdatHandle, out size_t length ), length );
             }
         }
 
@@ -44,6 +44,14 @@ public Context( )
         {
         }
 
+        /// <summary>Creates a new context with options</summary>
+        /// <param name="options">Options for the context</param>
+        public Context( ContextOptions options )
+            : this( CreateContextHandle( options ) )
+        {
+            StripDebugInfoOnLoad = options.StripDebugInfoOnLoad;
+        }
+
         ~Context( )
         {
             DisposeContext( );
@@ -59,6 +67,18 @@ public void Dispose( )
         /// <summary>Flag to indicate if this instance is still valid</summary>
         public bool IsDisposed => ContextHandle.Pointer == IntPtr.Zero;
 
+        /// <summary>Gets a value indicating whether the names of values, other than globals, are discarded</summary>
+        /// <seealso cref="ContextOptions.DiscardValueNames"/>
+        public bool DiscardValueNames => NativeMethods.ContextShouldDiscardValueNames( ContextHandle );
+
+        /// <summary>Gets a value indicating whether debug information is removed from modules loaded into this context</summary>
+        /// <seealso cref="ContextOptions.StripDebugInfoOnLoad"/>
+        public bool StripDebugInfoOnLoad { get; }
+
+        /// <summary>Gets a value indicating whether composite debug types are uniqued by their identifier</summary>
+        /// <seealso cref="ContextOptions.UniqueDebugTypes"/>
+        public bool UniqueDebugTypes => NativeMethods.ContextIsODRUniquingDebugTypes( ContextHandle );
+
         /// <summary>Get's the LLVM void type for this context</summary>
         public ITypeRef VoidType => TypeRef.FromHandle( NativeMethods.VoidTypeInContext( ContextHandle ) );
 
@@ -974,6 +994,19 @@ private void DisposeContext( )
             }
         }
 
+        private static LLVMContextRef CreateContextHandle( ContextOptions options )
+        {
+            if( options == null )
+            {
+                throw new ArgumentNullException( nameof( options ) );
+            }
+
+            var contextRef = NativeMethods.ContextCreate( );
+            NativeMethods.ContextSetDiscardValueNames( contextRef, options.DiscardValueNames );
+            NativeMethods.ContextSetODRUniquingDebugTypes( contextRef, options.UniqueDebugTypes );
+            return contextRef;
+        }
+
         private Context( LLVMContextRef contextRef )
         {
             ContextHandle = contextRef;
@@ -0,0 +1,31 @@
+﻿namespace Llvm.NET
+{
+    /// <summary>Options for creating a <see cref="Context"/></summary>
+    public class ContextOptions
+    {
+        /// <summary>Gets or sets a value indicating whether the names of values, other than globals, are discarded</summary>
+        /// <remarks>
+        /// Name strings account for a large share of the memory used by the IR, and are not needed
+        /// to generate code. Names of values created in, or loaded into, the context are dropped.
+        /// Globals keep their names as they are required for linking.
+        /// </remarks>
+        public bool DiscardValueNames { get; set; }
+
+        /// <summary>Gets or sets a value indicating whether debug information is removed from modules as they are loaded</summary>
+        /// <remarks>
+        /// This applies to modules loaded from bit-code with <see cref="NativeModule.LoadFrom(MemoryBuffer, Context)"/>
+        /// or <see cref="NativeModule.LoadLazilyFrom(MemoryBuffer, Context, bool)"/>.
+        /// </remarks>
+        public bool StripDebugInfoOnLoad { get; set; }
+
+        /// <summary>Gets or sets a value indicating whether composite debug types are uniqued by their identifier</summary>
+        /// <remarks>
+        /// Following the One Definition Rule, composite types with the same unique identifier are the same type.
+        /// When set, such types in modules loaded from bit-code, or linked with <see cref="NativeModule.LinkParallel(Context, System.Collections.Generic.IEnumerable{NativeModule}, int, out System.Collections.Generic.IReadOnlyList{LinkStageTiming})"/>,
+        /// reuse the definition already in the context instead of creating a duplicate. This keeps the types shared
+        /// by many modules (i.e. from common headers) from bloating the linked module and the generated debug information.
+        /// Types created with <see cref="DebugInfo.DebugInfoBuilder"/> are not uniqued.
+        /// </remarks>
+        public bool UniqueDebugTypes { get; set; }
+    }
+}
@@ -9,5 +9,11 @@ internal DICompileUnit( LLVMMetadataRef handle )
             : base( handle )
         {
         }
+
+        /// <summary>Gets the amount of debug information emitted for this compilation unit</summary>
+        public DwarfEmissionKind EmissionKind => ( DwarfEmissionKind )NativeMethods.DICompileUnitGetEmissionKind( MetadataHandle );
+
+        /// <summary>Gets the name of the split DWARF file for this compilation unit, or an empty string if not split</summary>
+        public string SplitDebugFileName => StringMarshaler.FromBorrowedName( NativeMethods.DICompileUnitGetSplitDebugFilename( MetadataHandle, out size_t length ), length );
     }
 }
@@ -11,9 +11,9 @@ internal DIFile( LLVMMetadataRef handle )
         {
         }
 
-        public string FileName => NativeMethods.GetDIFileName( MetadataHandle );
+        public string FileName => StringMarshaler.FromBorrowedName( NativeMethods.GetDIFileName( MetadataHandle, out size_t length ), length );
 
-        public string Directory => NativeMethods.GetDIFileDirectory( MetadataHandle );
+        public string Directory => StringMarshaler.FromBorrowedName( NativeMethods.GetDIFileDirectory( MetadataHandle, out size_t length ), length );
 
         public string Path => System.IO.Path.Combine( Directory, FileName );
     }
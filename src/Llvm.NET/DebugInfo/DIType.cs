@@ -74,6 +74,15 @@ public DIScope Scope
 
         public bool IsRvalueReference => DebugInfoFlags.HasFlag( DebugInfoFlags.RValueReference );
 
-        public string Name => NativeMethods.DITypeGetName( MetadataHandle );
+        public string Name => StringMarshaler.FromBorrowedName( NativeMethods.DITypeGetName( MetadataHandle, out size_t length ), length );
+
+        /// <summary>Retrieves all of the fields of this type with a single native call</summary>
+        /// <returns>Fields of the type</returns>
+        /// <seealso cref="DITypeInfo.FromTypes(System.Collections.Generic.IEnumerable{DIType})"/>
+        public DITypeInfo GetInfo( )
+        {
+            NativeMethods.DITypeGetInfo( MetadataHandle, out LLVMDITypeInfo info );
+            return new DITypeInfo( Context, this, ref info );
+        }
     }
 }
@@ -0,0 +1,135 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using Llvm.NET.Native;
+
+namespace Llvm.NET.DebugInfo
+{
+    /// <summary>Snapshot of all the fields of a <see cref="DIType"/></summary>
+    /// <remarks>
+    /// The fields are retrieved from the native type with a single call, which is considerably
+    /// faster than reading the properties of the type one at a time when large numbers of
+    /// types are processed. Fields that don't apply to the kind of type are <see langword="null"/>
+    /// or 0.
+    /// </remarks>
+    public class DITypeInfo
+    {
+        /// <summary>Gets the type the fields were retrieved from</summary>
+        public DIType Type { get; }
+
+        /// <summary>Gets the Dwarf tag of the type</summary>
+        public Tag Tag { get; }
+
+        /// <summary>Gets the name of the type</summary>
+        public string Name { get; }
+
+        /// <summary>Gets the scope containing the type</summary>
+        public DIScope Scope { get; }
+
+        /// <summary>Gets the file containing the type</summary>
+        public DIFile File { get; }
+
+        /// <summary>Gets the line of the type declaration</summary>
+        public uint Line { get; }
+
+        /// <summary>Gets the size of the type in bits</summary>
+        public ulong BitSize { get; }
+
+        /// <summary>Gets the alignment of the type in bits</summary>
+        public ulong BitAlignment { get; }
+
+        /// <summary>Gets the offset of the type in bits</summary>
+        public ulong BitOffset { get; }
+
+        /// <summary>Gets the flags of the type</summary>
+        public DebugInfoFlags DebugInfoFlags { get; }
+
+        /// <summary>Gets the base type of a derived or composite type</summary>
+        public DIType BaseType { get; }
+
+        /// <summary>Gets the extra data of a derived type</summary>
+        public LlvmMetadata ExtraData { get; }
+
+        /// <summary>Gets the elements of a composite type</summary>
+        public IReadOnlyList<DINode> Elements { get; }
+
+        /// <summary>Gets the type containing the virtual table of a composite type</summary>
+        public DIType VTableHolder { get; }
+
+        /// <summary>Gets the template parameters of a composite type</summary>
+        public MDTuple TemplateParameters { get; }
+
+        /// <summary>Gets the unique identifier of a composite type</summary>
+        public string Identifier { get; }
+
+        /// <summary>Gets the runtime language of a composite type</summary>
+        public uint RuntimeLanguage { get; }
+
+        /// <summary>Gets the encoding of a basic type</summary>
+        public DiTypeKind Encoding { get; }
+
+        /// <summary>Retrieves the fields of a set of types</summary>
+        /// <param name="types">Types to retrieve the fields of</param>
+        /// <returns>Fields of each of the types, in the same order as <paramref name="types"/></returns>
+        /// <remarks>The fields of all of the types are retrieved in a single native call</remarks>
+        public static IReadOnlyList<DITypeInfo> FromTypes( IEnumerable<DIType> types )
+        {
+            if( types == null )
+            {
+                throw new ArgumentNullException( nameof( types ) );
+            }
+
+            var typeList = types as IList<DIType> ?? types.ToList( );
+            if( typeList.Count == 0 )
+            {
+                return new DITypeInfo[ 0 ];
+            }
+
+            var handles = new LLVMMetadataRef[ typeList.Count ];
+            for( int i = 0; i < handles.Length; ++i )
+            {
+                handles[ i ] = typeList[ i ]?.MetadataHandle ?? throw new ArgumentException( "Types must not be null", nameof( types ) );
+            }
+
+            var infos = new LLVMDITypeInfo[ handles.Length ];
+            NativeMethods.DITypeGetInfoArray( handles, ( size_t )handles.Length, infos );
+
+            var context = typeList[ 0 ].Context;
+            var retVal = new DITypeInfo[ infos.Length ];
+            for( int i = 0; i < infos.Length; ++i )
+            {
+                retVal[ i ] = new DITypeInfo( context, typeList[ i ], ref infos[ i ] );
+            }
+
+            return retVal;
+        }
+
+        internal DITypeInfo( Context context, DIType type, ref LLVMDITypeInfo info )
+        {
+            Type = type;
+            Tag = ( Tag )info.Tag;
+            Name = StringMarshaler.FromBorrowedName( info.Name, info.NameLength );
+            Scope = LlvmMetadata.FromHandle<DIScope>( context, info.Scope );
+            File = LlvmMetadata.FromHandle<DIFile>( context, info.File );
+            Line = info.Line;
+            BitSize = info.SizeInBits;
+            BitAlignment = info.AlignInBits;
+            BitOffset = info.OffsetInBits;
+            DebugInfoFlags = ( DebugInfoFlags )info.Flags;
+            BaseType = LlvmMetadata.FromHandle<DIType>( context, info.BaseType );
+            ExtraData = LlvmMetadata.FromHandle<LlvmMetadata>( context, info.ExtraData );
+
+            var elements = LlvmMetadata.FromHandle<MDTuple>( context, info.Elements );
+            if( elements != null )
+            {
+                Elements = new TupleTypedArrayWrapper<DINode>( elements );
+            }
+
+            VTableHolder = LlvmMetadata.FromHandle<DIType>( context, info.VTableHolder );
+            TemplateParameters = LlvmMetadata.FromHandle<MDTuple>( context, info.TemplateParams );
+            Identifier = StringMarshaler.FromBorrowedName( info.Identifier, info.IdentifierLength );
+            RuntimeLanguage = info.RuntimeLang;
+            Encoding = ( DiTypeKind )info.Encoding;
+        }
+    }
+}
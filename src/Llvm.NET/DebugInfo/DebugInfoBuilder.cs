@@ -6,6 +6,7 @@
 using System.Text;
 using Llvm.NET.Instructions;
 using Llvm.NET.Native;
+using Llvm.NET.Types;
 using Llvm.NET.Values;
 
 namespace Llvm.NET.DebugInfo
@@ -67,6 +68,48 @@ public sealed class DebugInfoBuilder : IDisposable
                                               , string compilationFlags
                                               , uint runtimeVersion
                                               )
+        {
+            return CreateCompileUnit( language
+                                    , fileName
+                                    , fileDirectory
+                                    , producer
+                                    , optimized
+                                    , compilationFlags
+                                    , runtimeVersion
+                                    , DwarfEmissionKind.Full
+                                    , null
+                                    );
+        }
+
+        /// <summary>Creates a new <see cref="DICompileUnit"/></summary>
+        /// <param name="language"><see cref="SourceLanguage"/> for the compilation unit</param>
+        /// <param name="fileName">Name of the source file of this compilation unit (without any path)</param>
+        /// <param name="fileDirectory">Path of the directory containing the file</param>
+        /// <param name="producer">Name of the application processing the compilation unit</param>
+        /// <param name="optimized">Flag to indicate if the code in this compilation unit is optimized</param>
+        /// <param name="compilationFlags">Additional tool specific flags</param>
+        /// <param name="runtimeVersion">Runtime version</param>
+        /// <param name="emissionKind">Amount of debug information code generation emits for the compilation unit</param>
+        /// <param name="splitDebugFileName">Name of the split DWARF (.dwo) file for the compilation unit, or <see langword="null"/> if not split</param>
+        /// <returns><see cref="DICompileUnit"/></returns>
+        /// <remarks>
+        /// The emission kind is applied when generating code for the module. With <see cref="DwarfEmissionKind.LineTablesOnly"/>
+        /// only the line tables are emitted, regardless of any type or variable information in the module.
+        /// <para>Code generation only splits the debug information when split DWARF is enabled with
+        /// <see cref="StaticState.EnableSplitDwarf"/>, <paramref name="splitDebugFileName"/> is recorded as the name
+        /// of the .dwo file in the skeleton compilation unit.</para>
+        /// </remarks>
+        [SuppressMessage( "Microsoft.Naming", "CA2204:Literals should be spelled correctly", MessageId = "DICompileUnit", Justification = "It is spelled correctly 8^)" )]
+        public DICompileUnit CreateCompileUnit( SourceLanguage language
+                                              , string fileName
+                                              , string fileDirectory
+                                              , string producer
+                                              , bool optimized
+                                              , string compilationFlags
+                                              , uint runtimeVersion
+                                              , DwarfEmissionKind emissionKind
+                                              , string splitDebugFileName
+                                              )
         {
             if( OwningModule.DICompileUnit != null )
             {
@@ -81,6 +124,8 @@ public sealed class DebugInfoBuilder : IDisposable
                                                                  , optimized ? 1 : 0
                                                                  , compilationFlags
                                                                  , runtimeVersion
+                                                                 , ( LLVMDwarfEmissionKind )emissionKind
+                                                                 , splitDebugFileName
                                                                  );
             var retVal = MDNode.FromHandle<DICompileUnit>( handle );
             OwningModule.DICompileUnit = retVal;
@@ -548,6 +593,65 @@ public DISubroutineType CreateSubroutineType( DebugInfoFlags debugFlags, DIType
             return CreateStructType( scope, name, file, line, bitSize, bitAlign, ( uint )debugFlags, derivedFrom, GetOrCreateArray( elements ) );
         }
 
+        /// <summary>Creates a structure type together with all of its members</summary>
+        /// <param name="scope">Scope containing the type</param>
+        /// <param name="name">Name of the type</param>
+        /// <param name="file">File containing the type declaration</param>
+        /// <param name="line">Line of the type declaration</param>
+        /// <param name="bitSize">Size of the type in bits</param>
+        /// <param name="bitAlign">Alignment of the type in bits</param>
+        /// <param name="debugFlags">Flags for the type</param>
+        /// <param name="derivedFrom">Type this type derives from, if any</param>
+        /// <param name="nativeType">LLVM structure type used for the layout of members without an <see cref="DebugMemberInfo.ExplicitLayout"/></param>
+        /// <param name="members">Descriptions of the members of the type</param>
+        /// <returns>New type</returns>
+        /// <remarks>
+        /// The type and its members are created in a single native call, which avoids a separate call per
+        /// member and element array. The members are scoped to a replaceable temporary type, which is then
+        /// replaced by the final type and deleted.
+        /// </remarks>
+        public DICompositeType CreateStructType( DIScope scope
+                                               , string name
+                                               , DIFile file
+                                               , uint line
+                                               , UInt64 bitSize
+                                               , UInt32 bitAlign
+                                               , DebugInfoFlags debugFlags
+                                               , DIType derivedFrom
+                                               , IStructType nativeType
+                                               , IEnumerable<DebugMemberInfo> members
+                                               )
+        {
+            return CreateCompositeType( Tag.StructureType, scope, name, file, line, bitSize, bitAlign, debugFlags, derivedFrom, nativeType, members );
+        }
+
+        /// <summary>Creates a class type together with all of its members</summary>
+        /// <param name="scope">Scope containing the type</param>
+        /// <param name="name">Name of the type</param>
+        /// <param name="file">File containing the type declaration</param>
+        /// <param name="line">Line of the type declaration</param>
+        /// <param name="bitSize">Size of the type in bits</param>
+        /// <param name="bitAlign">Alignment of the type in bits</param>
+        /// <param name="debugFlags">Flags for the type</param>
+        /// <param name="derivedFrom">Type this type derives from, if any</param>
+        /// <param name="nativeType">LLVM structure type used for the layout of members without an <see cref="DebugMemberInfo.ExplicitLayout"/></param>
+        /// <param name="members">Descriptions of the members of the type</param>
+        /// <returns>New type</returns>
+        public DICompositeType CreateClassType( DIScope scope
+                                              , string name
+                                              , DIFile file
+                                              , uint line
+                                              , UInt64 bitSize
+                                              , UInt32 bitAlign
+                                              , DebugInfoFlags debugFlags
+                                              , DIType derivedFrom
+                                              , IStructType nativeType
+                                              , IEnumerable<DebugMemberInfo> members
+                                              )
+        {
+            return CreateCompositeType( Tag.ClassType, scope, name, file, line, bitSize, bitAlign, debugFlags, derivedFrom, nativeType, members );
+        }
+
         [System.Diagnostics.CodeAnalysis.SuppressMessage( "Microsoft.Design", "CA1011:ConsiderPassingBaseTypesAsParameters", Justification = "Specific type required by interop call" )]
         public DICompositeType CreateUnionType( DIScope scope
                                               , string name
@@ -608,6 +712,83 @@ public DISubroutineType CreateSubroutineType( DebugInfoFlags debugFlags, DIType
             return CreateUnionType( scope, name, file, line, bitSize, bitAlign, ( uint )debugFlags, GetOrCreateArray( elements ) );
         }
 
+        private DICompositeType CreateCompositeType( Tag tag
+                                                   , DIScope scope
+                                                   , string name
+                                                   , DIFile file
+                                                   , uint line
+                                                   , UInt64 bitSize
+                                                   , UInt32 bitAlign
+                                                   , DebugInfoFlags debugFlags
+                                                   , DIType derivedFrom
+                                                   , IStructType nativeType
+                                                   , IEnumerable<DebugMemberInfo> members
+                                                   )
+        {
+            if( scope == null )
+            {
+                throw new ArgumentNullException( nameof( scope ) );
+            }
+
+            if( nativeType == null )
+            {
+                throw new ArgumentNullException( nameof( nativeType ) );
+            }
+
+            if( members == null )
+            {
+                throw new ArgumentNullException( nameof( members ) );
+            }
+
+            var memberList = members as IList<DebugMemberInfo> ?? members.ToList( );
+            var names = new byte[ memberList.Sum( m => Encoding.UTF8.GetByteCount( m.Name ?? string.Empty ) ) ];
+            var descriptors = new LLVMDIMemberDescriptor[ memberList.Count ];
+            int nameOffset = 0;
+            for( int i = 0; i < memberList.Count; ++i )
+            {
+                var memberInfo = memberList[ i ];
+                if( memberInfo.DebugType == null )
+                {
+                    throw new ArgumentException( "Member has no debug type", nameof( members ) );
+                }
+
+                int nameLength = Encoding.UTF8.GetBytes( memberInfo.Name ?? string.Empty, 0, memberInfo.Name?.Length ?? 0, names, nameOffset );
+
+                // if explicit layout info provided, use it;
+                // otherwise use module.Layout as the default
+                var layout = memberInfo.ExplicitLayout;
+                descriptors[ i ] = new LLVMDIMemberDescriptor
+                {
+                    Type = memberInfo.DebugType.DIType.MetadataHandle,
+                    File = memberInfo.File?.MetadataHandle ?? LLVMMetadataRef.Zero,
+                    SizeInBits = layout?.BitSize ?? OwningModule.Layout.BitSizeOf( memberInfo.DebugType.NativeType ),
+                    OffsetInBits = layout?.BitOffset ?? OwningModule.Layout.BitOffsetOfElement( nativeType, memberInfo.Index ),
+                    NameOffset = ( size_t )nameOffset,
+                    NameLength = ( size_t )nameLength,
+                    Line = memberInfo.Line,
+                    AlignInBits = layout?.BitAlignment ?? 0,
+                    Flags = ( uint )memberInfo.DebugInfoFlags
+                };
+                nameOffset += nameLength;
+            }
+
+            var handle = NativeMethods.DIBuilderCreateCompositeTypeWithMembers( BuilderHandle
+                                                                              , ( uint )tag
+                                                                              , scope.MetadataHandle
+                                                                              , name
+                                                                              , file?.MetadataHandle ?? LLVMMetadataRef.Zero
+                                                                              , line
+                                                                              , bitSize
+                                                                              , bitAlign
+                                                                              , ( uint )debugFlags
+                                                                              , derivedFrom?.MetadataHandle ?? LLVMMetadataRef.Zero
+                                                                              , descriptors
+                                                                              , ( size_t )descriptors.Length
+                                                                              , names
+                                                                              );
+            return MDNode.FromHandle<DICompositeType>( handle );
+        }
+
         [System.Diagnostics.CodeAnalysis.SuppressMessage( "Microsoft.Design", "CA1011:ConsiderPassingBaseTypesAsParameters", Justification = "Specific type required by interop call" )]
         public DIDerivedType CreateMemberType( DIScope scope
                                              , string name
@@ -1,5 +1,4 @@
-﻿using System;
-using System.Collections.Generic;
+﻿using System.Collections.Generic;
 using System.Collections.ObjectModel;
 using System.Linq;
 using Llvm.NET.Types;
@@ -28,29 +27,17 @@ public class DebugStructType
             DebugMembers = new ReadOnlyCollection<DebugMemberInfo>( debugElements as IList<DebugMemberInfo> ?? debugElements.ToList( ) );
 
             NativeType = module.Context.CreateStructType( nativeName, packed, debugElements.Select( e => e.DebugType ).ToArray( ) );
-            DIType =  module.DIBuilder.CreateReplaceableCompositeType( Tag.StructureType
-                                                                     , name
-                                                                     , scope
-                                                                     , diFile
-                                                                     , line
-                                                                     );
-
-            var memberTypes = from memberInfo in DebugMembers
-                              select CreateMemberType( module, memberInfo );
-
-            var concreteType = module.DIBuilder.CreateStructType( scope: scope
-                                                                , name: name
-                                                                , file: diFile
-                                                                , line: line
-                                                                , bitSize: bitSize ?? module.Layout.BitSizeOf( NativeType )
-                                                                , bitAlign: bitAlignment
-                                                                , debugFlags: debugFlags
-                                                                , derivedFrom: derivedFrom
-                                                                , elements: memberTypes
-                                                                );
-
-            // assignment performs RAUW
-            DIType = concreteType;
+            DIType = module.DIBuilder.CreateStructType( scope: scope
+                                                      , name: name
+                                                      , file: diFile
+                                                      , line: line
+                                                      , bitSize: bitSize ?? module.Layout.BitSizeOf( NativeType )
+                                                      , bitAlign: bitAlignment
+                                                      , debugFlags: debugFlags
+                                                      , derivedFrom: derivedFrom
+                                                      , nativeType: NativeType
+                                                      , members: DebugMembers
+                                                      );
         }
 
         [System.Diagnostics.CodeAnalysis.SuppressMessage( "Microsoft.Design", "CA1062:Validate arguments of public methods", MessageId = "1", Justification = "VerifyArgNotNull" )]
@@ -159,9 +146,6 @@ public void SetBody( bool packed, params ITypeRef[ ] elements )
         {
             DebugMembers = new ReadOnlyCollection<DebugMemberInfo>( debugElements as IList<DebugMemberInfo> ?? debugElements.ToList( ) );
             SetBody( packed, nativeElements.ToArray() );
-            var memberTypes = from memberInfo in DebugMembers
-                              select CreateMemberType( module, memberInfo );
-
             var concreteType = module.DIBuilder.CreateStructType( scope: scope
                                                                 , name: DIType.Name
                                                                 , file: diFile
@@ -170,42 +154,12 @@ public void SetBody( bool packed, params ITypeRef[ ] elements )
                                                                 , bitAlign: bitAlignment
                                                                 , debugFlags: debugFlags
                                                                 , derivedFrom: derivedFrom
-                                                                , elements: memberTypes
+                                                                , nativeType: NativeType
+                                                                , members: DebugMembers
                                                                 );
-            DIType = concreteType;
-        }
 
-        private DIDerivedType CreateMemberType( NativeModule module, DebugMemberInfo memberInfo )
-        {
-            UInt64 bitSize;
-            UInt32 bitAlign;
-            UInt64 bitOffset;
-
-            // if explicit layout info provided, use it;
-            // otherwise use module.Layout as the default
-            if( memberInfo.ExplicitLayout != null )
-            {
-                bitSize = memberInfo.ExplicitLayout.BitSize;
-                bitAlign = memberInfo.ExplicitLayout.BitAlignment;
-                bitOffset = memberInfo.ExplicitLayout.BitOffset;
-            }
-            else
-            {
-                bitSize = module.Layout.BitSizeOf( memberInfo.DebugType.NativeType );
-                bitAlign = 0;
-                bitOffset = module.Layout.BitOffsetOfElement( NativeType, memberInfo.Index );
-            }
-
-            return module.DIBuilder.CreateMemberType( scope: DIType
-                                                    , name: memberInfo.Name
-                                                    , file: memberInfo.File
-                                                    , line: memberInfo.Line
-                                                    , bitSize: bitSize
-                                                    , bitAlign: bitAlign
-                                                    , bitOffset: bitOffset
-                                                    , debugFlags: memberInfo.DebugInfoFlags
-                                                    , type: memberInfo.DebugType.DIType
-                                                    );
+            // assignment performs RAUW
+            DIType = concreteType;
         }
 
         public IReadOnlyList<DebugMemberInfo> DebugMembers { get; private set; }
@@ -135,6 +135,19 @@ public enum Tag : ushort
         HiUser = LLVMDwarfTag.HiUser
     }
 
+    /// <summary>Amount of debug information emitted for a <see cref="DICompileUnit"/></summary>
+    public enum DwarfEmissionKind
+    {
+        /// <summary>No debug information is emitted</summary>
+        None = LLVMDwarfEmissionKind.None,
+
+        /// <summary>Full debug information, including types and variables</summary>
+        Full = LLVMDwarfEmissionKind.Full,
+
+        /// <summary>Only line tables are emitted, which is enough for symbolizing addresses (i.e. in profiles)</summary>
+        LineTablesOnly = LLVMDwarfEmissionKind.LineTablesOnly
+    }
+
     public enum QualifiedTypeTag
     {
         None = 0,
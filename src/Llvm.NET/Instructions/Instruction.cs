@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Collections.Generic;
 using Llvm.NET.Native;
 using Llvm.NET.Values;
 
@@ -51,5 +52,17 @@ internal Instruction( LLVMValueRef valueRef )
             : base( valueRef )
         {
         }
+
+        // creates the managed wrappers for the results of a bulk instruction enumeration
+        internal static IReadOnlyList<Instruction> FromInstructionInfos( Context context, LLVMInstructionInfo[ ] infos )
+        {
+            var retVal = new Instruction[ infos.Length ];
+            for( int i = 0; i < infos.Length; ++i )
+            {
+                retVal[ i ] = FromHandle<Instruction>( context, infos[ i ].Instruction, ( ValueKind )infos[ i ].ValueID );
+            }
+
+            return retVal;
+        }
     }
 }
@@ -0,0 +1,75 @@
+﻿using System;
+using Llvm.NET.Native;
+
+namespace Llvm.NET
+{
+    /// <summary>Options for optimizing a module with <see cref="NativeModule.Optimize(TargetMachine, LegacyOptimizerOptions)"/></summary>
+    /// <remarks>
+    /// These are equivalent to the options of the same name for the LLVM 'opt' tool.
+    /// </remarks>
+    public class LegacyOptimizerOptions
+    {
+        /// <summary>Gets or sets the comma separated list of passes to run, in order</summary>
+        /// <remarks>
+        /// The list contains the command line names of legacy passes (e.g. "instcombine,gvn"). The
+        /// names "O1", "O2", "O3", "Os", "Oz" and "std-link-opts" add the corresponding standard
+        /// pipeline at that point of the list.
+        /// </remarks>
+        public string Passes { get; set; }
+
+        /// <summary>Gets or sets a value indicating whether interprocedural optimizations are disabled</summary>
+        public bool DisableUnitAtATime { get; set; }
+
+        /// <summary>Gets or sets a value indicating whether loop unrolling is disabled</summary>
+        public bool DisableLoopUnrolling { get; set; }
+
+        /// <summary>Gets or sets a value indicating whether the loop vectorization pass is disabled</summary>
+        public bool DisableLoopVectorization { get; set; }
+
+        /// <summary>Gets or sets a value indicating whether the SLP vectorization pass is disabled</summary>
+        public bool DisableSLPVectorization { get; set; }
+
+        /// <summary>Gets or sets a value indicating whether the simplification of library calls is disabled</summary>
+        public bool DisableSimplifyLibCalls { get; set; }
+
+        /// <summary>Gets or sets a value indicating whether the coroutine passes are enabled</summary>
+        public bool EnableCoroutines { get; set; }
+
+        /// <summary>Gets or sets a value indicating whether names of values (other than globals) are discarded</summary>
+        /// <remarks>
+        /// This only applies to values created by the optimizations, existing values keep their names. To avoid
+        /// creating value names at all, use <see cref="ContextOptions.DiscardValueNames"/> when creating the context.
+        /// </remarks>
+        public bool DiscardValueNames { get; set; }
+
+        /// <summary>Gets or sets a value indicating whether optimization remarks include profile counts</summary>
+        public bool PassRemarksWithHotness { get; set; }
+
+        /// <summary>Gets or sets the number of threads used to run the function passes of the standard pipelines</summary>
+        /// <remarks>
+        /// When greater than 1, the function definitions are partitioned across this many worker threads, each
+        /// with its own function pass manager and private copy of its functions. The optimized functions then
+        /// replace the originals in the module, which is deterministic regardless of thread scheduling. However,
+        /// any <see cref="Values.Function"/> instances obtained from the module before optimizing are invalid
+        /// afterwards.
+        /// </remarks>
+        public int WorkerCount { get; set; } = 1;
+
+        internal LLVMLegacyOptimizerOptions ToNative( )
+        {
+            return new LLVMLegacyOptimizerOptions
+            {
+                Passes = Passes,
+                DisableUnitAtATime = DisableUnitAtATime,
+                DisableLoopUnrolling = DisableLoopUnrolling,
+                DisableLoopVectorization = DisableLoopVectorization,
+                DisableSLPVectorization = DisableSLPVectorization,
+                DisableSimplifyLibCalls = DisableSimplifyLibCalls,
+                EnableCoroutines = EnableCoroutines,
+                DiscardValueNames = DiscardValueNames,
+                PassRemarksWithHotness = PassRemarksWithHotness,
+                WorkerCount = ( uint )Math.Max( 1, WorkerCount )
+            };
+        }
+    }
+}
@@ -0,0 +1,21 @@
+﻿using Llvm.NET.Native;
+
+namespace Llvm.NET
+{
+    /// <summary>Stages of a parallel module link</summary>
+    /// <seealso cref="NativeModule.LinkParallel(Context, System.Collections.Generic.IEnumerable{NativeModule}, int, out System.Collections.Generic.IReadOnlyList{LinkStageTiming})"/>
+    public enum LinkStageKind
+    {
+        /// <summary>Writing the input modules to bit-code</summary>
+        Serialize = LLVMLinkStageKind.Serialize,
+
+        /// <summary>Loading each input into a private context</summary>
+        Load = LLVMLinkStageKind.Load,
+
+        /// <summary>One level of the merge tree</summary>
+        Merge = LLVMLinkStageKind.Merge,
+
+        /// <summary>Moving the linked result into the destination context</summary>
+        Finalize = LLVMLinkStageKind.Finalize
+    }
+}
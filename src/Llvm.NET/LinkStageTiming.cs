@@ -0,0 +1,37 @@
+﻿using System;
+using Llvm.NET.Native;
+
+namespace Llvm.NET
+{
+    /// <summary>Timing of one stage of a parallel module link</summary>
+    public struct LinkStageTiming
+    {
+        /// <summary>Kind of stage</summary>
+        public LinkStageKind Kind { get; }
+
+        /// <summary>Level of the merge tree for <see cref="LinkStageKind.Merge"/> stages, 0 for all others</summary>
+        public int Level { get; }
+
+        /// <summary>Number of modules processed, or pairs merged, in the stage</summary>
+        public int TaskCount { get; }
+
+        /// <summary>Number of composite debug types that reused an existing definition in the stage</summary>
+        /// <remarks>
+        /// This is only non-zero for <see cref="LinkStageKind.Merge"/> and <see cref="LinkStageKind.Finalize"/>
+        /// stages of a link into a context with <see cref="Context.UniqueDebugTypes"/> set.
+        /// </remarks>
+        public int DeduplicatedDebugTypeCount { get; }
+
+        /// <summary>Elapsed wall clock time of the stage</summary>
+        public TimeSpan WallTime { get; }
+
+        internal LinkStageTiming( LLVMLinkStageTiming nativeTiming )
+        {
+            Kind = ( LinkStageKind )nativeTiming.Kind;
+            Level = ( int )nativeTiming.Level;
+            TaskCount = ( int )nativeTiming.TaskCount;
+            DeduplicatedDebugTypeCount = ( int )nativeTiming.DeduplicatedTypeCount;
+            WallTime = TimeSpan.FromTicks( ( long )( nativeTiming.WallTimeInSeconds * TimeSpan.TicksPerSecond ) );
+        }
+    }
+}
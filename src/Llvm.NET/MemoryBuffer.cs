@@ -21,6 +21,39 @@ public MemoryBuffer( string path )
             throw new InternalCodeGeneratorException( msg );
         }
 
+        /// <summary>Creates a read-only buffer for a file, memory mapping it when large enough to benefit from it</summary>
+        /// <param name="path">Path of the file to map</param>
+        /// <returns>Buffer for the contents of the file</returns>
+        /// <remarks>
+        /// Bit-code and object files are parsed directly from the mapped memory, so the contents of
+        /// large files are never copied into the process heap. (Whether a file is mapped or read is
+        /// determined by LLVM based on its size, see <see cref="IsMemoryMapped"/>.)
+        /// </remarks>
+        public static MemoryBuffer MapFile( string path )
+        {
+            if( string.IsNullOrWhiteSpace( path ) )
+            {
+                throw new ArgumentException( "path cannot be null or an empty string", nameof( path ) );
+            }
+
+            if( NativeMethods.CreateMemoryBufferWithMappedFile( path, out LLVMMemoryBufferRef bufferHandle, out string msg ).Failed )
+            {
+                throw new InternalCodeGeneratorException( msg );
+            }
+
+            return new MemoryBuffer( bufferHandle );
+        }
+
+        /// <summary>Flag to indicate if the contents of the buffer are memory mapped from a file</summary>
+        public bool IsMemoryMapped => BufferHandle.Pointer != IntPtr.Zero && NativeMethods.MemoryBufferIsMemoryMapped( BufferHandle );
+
+        /// <summary>Pointer to the start of the buffer's contents</summary>
+        /// <remarks>
+        /// Together with <see cref="Size"/> this provides a view of the contents without copying them into
+        /// managed memory (as <see cref="ToArray"/> does). The pointer is only valid until the buffer is disposed.
+        /// </remarks>
+        public IntPtr Start => BufferHandle.Pointer == IntPtr.Zero ? IntPtr.Zero : NativeMethods.GetBufferStart( BufferHandle );
+
         /// <summary>Size of the buffer</summary>
         public int Size
         {
@@ -59,6 +92,12 @@ internal MemoryBuffer( LLVMMemoryBufferRef bufferHandle )
 
         internal LLVMMemoryBufferRef BufferHandle => BufferHandle_;
 
+        // ownership of the native buffer was transferred elsewhere (i.e. to a lazily loaded module)
+        internal void Detach( )
+        {
+            BufferHandle_ = default( LLVMMemoryBufferRef );
+        }
+
         // keep as a private field so this is usable as an out parameter in constructor
         // do not write to it directly, treat it as readonly.
         [SuppressMessage( "StyleCop.CSharp.NamingRules"
@@ -1,6 +1,7 @@
 using System;
 using System.Collections.Generic;
 using System.Diagnostics.CodeAnalysis;
+using System.Linq;
 using Llvm.NET.Native;
 
 namespace Llvm.NET
@@ -55,6 +56,61 @@ public override void ReplaceAllUsesWith( LlvmMetadata other )
             MetadataHandle = LLVMMetadataRef.Zero;
         }
 
+        /// <summary>Replaces all uses of a set of temporary nodes and deletes the temporaries</summary>
+        /// <param name="replacements">Pairs of temporary node and the node to replace it with</param>
+        /// <remarks>
+        /// This is intended for resolving the forward declarations of large (possibly recursive) type
+        /// graphs. All of the replacements are done in a single native call, which then resolves any
+        /// cycles among the replacements once, instead of once per replaced node. A replacement may
+        /// refer to, or be, another temporary in <paramref name="replacements"/>. The temporary nodes
+        /// are deleted and are not valid for use when this method returns.
+        /// </remarks>
+        [SuppressMessage( "Microsoft.Design", "CA1006:DoNotNestGenericTypesInMemberSignatures", Justification = "Pairs are the natural form of the replacements" )]
+        public static void ReplaceTemporaries( IEnumerable<KeyValuePair<MDNode, LlvmMetadata>> replacements )
+        {
+            if( replacements == null )
+            {
+                throw new ArgumentNullException( nameof( replacements ) );
+            }
+
+            var replacementList = replacements as IList<KeyValuePair<MDNode, LlvmMetadata>> ?? replacements.ToList( );
+            var temporaryHandles = new LLVMMetadataRef[ replacementList.Count ];
+            var replacementHandles = new LLVMMetadataRef[ replacementList.Count ];
+            var contexts = new Context[ replacementList.Count ];
+            for( int i = 0; i < replacementList.Count; ++i )
+            {
+                var temporary = replacementList[ i ].Key;
+                var replacement = replacementList[ i ].Value;
+                if( temporary == null || replacement == null )
+                {
+                    throw new ArgumentException( "Nodes must not be null", nameof( replacements ) );
+                }
+
+                if( temporary.IsDeleted || !temporary.IsTemporary )
+                {
+                    throw new ArgumentException( "Only temporary nodes can be replaced", nameof( replacements ) );
+                }
+
+                temporaryHandles[ i ] = temporary.MetadataHandle;
+                replacementHandles[ i ] = replacement.MetadataHandle;
+                contexts[ i ] = temporary.Context;
+            }
+
+            if( temporaryHandles.Distinct( ).Count( ) != temporaryHandles.Length )
+            {
+                throw new ArgumentException( "Each temporary node can only be replaced once", nameof( replacements ) );
+            }
+
+            NativeMethods.MetadataReplaceAllTemporaries( temporaryHandles, replacementHandles, ( size_t )temporaryHandles.Length );
+
+            for( int i = 0; i < replacementList.Count; ++i )
+            {
+                var temporary = replacementList[ i ].Key;
+                contexts[ i ].RemoveDeletedNode( temporary );
+                temporary.MetadataHandle = LLVMMetadataRef.Zero;
+            }
+        }
+
         internal static T FromHandle<T>( LLVMMetadataRef handle )
         where T : MDNode
         {
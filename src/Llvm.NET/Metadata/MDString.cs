@@ -1,3 +1,4 @@
+using System;
 using Llvm.NET.Native;
 
 namespace Llvm.NET
@@ -12,7 +13,8 @@ internal MDString( LLVMMetadataRef handle )
 
         public override string ToString( )
         {
-            return NativeMethods.GetMDStringText( MetadataHandle, out uint len );
+            IntPtr text = NativeMethods.GetMDStringText( MetadataHandle, out uint len );
+            return StringMarshaler.FromBorrowedName( text, ( size_t )( int )len );
         }
     }
 }
\ No newline at end of file
@@ -51,7 +51,7 @@ public override string ToString( )
                 return string.Empty;
             }
 
-            return NativeMethods.MetadataAsString( MetadataHandle );
+            return StringMarshaler.FromBorrowed( NativeMethods.MetadataAsString( MetadataHandle, out size_t length ), length );
         }
 
         internal LLVMMetadataRef MetadataHandle { get; /*protected*/ set; }
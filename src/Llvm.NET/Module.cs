@@ -3,7 +3,11 @@
 using System.Diagnostics;
 using System.Diagnostics.CodeAnalysis;
 using System.IO;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Text;
 using Llvm.NET.DebugInfo;
+using Llvm.NET.Instructions;
 using Llvm.NET.Native;
 using Llvm.NET.Types;
 using Llvm.NET.Values;
@@ -263,11 +267,30 @@ public IEnumerable<Function> Functions
             }
         }
 
+        /// <summary>All instructions of all the functions in this module</summary>
+        /// <remarks>
+        /// The instructions are retrieved with a single native call, in function then block order.
+        /// </remarks>
+        public IReadOnlyList<Instruction> Instructions
+        {
+            get
+            {
+                uint count = NativeMethods.ModuleGetInstructionInfos( ModuleHandle, null, 0 );
+                var infos = new LLVMInstructionInfo[ count ];
+                if( count > 0 )
+                {
+                    NativeMethods.ModuleGetInstructionInfos( ModuleHandle, infos, count );
+                }
+
+                return Instruction.FromInstructionInfos( Context, infos );
+            }
+        }
+
         // TODO: Add enumerator for GlobalAlias(s)
         // TODO: Add enumerator for NamedMDNode(s)
 
         /// <summary>Name of the module</summary>
-        public string Name => NativeMethods.GetModuleName( ModuleHandle );
+        public string Name => StringMarshaler.FromBorrowedName( NativeMethods.GetModuleName( ModuleHandle, out size_t length ), length );
 
         public void Link( NativeModule otherModule )
         {
@@ -286,8 +309,82 @@ public void Link( NativeModule otherModule )
                 throw new InternalCodeGeneratorException( "Module link error" );
             }
 
-            Context.RemoveModule( otherModule );
-            otherModule.ModuleHandle = new LLVMModuleRef( IntPtr.Zero );
+            otherModule.Detach( );
+        }
+
+        /// <summary>Links a set of modules into a new module using a parallel merge tree</summary>
+        /// <param name="context">Context for the linked module</param>
+        /// <param name="modules">Modules to link</param>
+        /// <param name="workerCount">Maximum number of threads to use</param>
+        /// <returns>New module containing the linked contents of all the <paramref name="modules"/></returns>
+        public static NativeModule LinkParallel( Context context, IEnumerable<NativeModule> modules, int workerCount )
+        {
+            return LinkParallel( context, modules, workerCount, out IReadOnlyList<LinkStageTiming> stageTimings );
+        }
+
+        /// <summary>Links a set of modules into a new module using a parallel merge tree</summary>
+        /// <param name="context">Context for the linked module</param>
+        /// <param name="modules">Modules to link</param>
+        /// <param name="workerCount">Maximum number of threads to use</param>
+        /// <param name="stageTimings">Timing for each stage of the link</param>
+        /// <returns>New module containing the linked contents of all the <paramref name="modules"/></returns>
+        /// <remarks>
+        /// <para>Each module is loaded into a private context, then each level of a binary tree links pairs of modules
+        /// concurrently until only one remains. This avoids the ever growing destination module of repeated calls to
+        /// <see cref="Link(NativeModule)"/> and uses multiple threads. The order of the merges is fixed, so the
+        /// result is deterministic. However, conflicting local symbols are renamed in the order of the merge tree,
+        /// so their names may differ from linking the modules, in order, into the first one.</para>
+        /// <para>Unlike <see cref="Link(NativeModule)"/> the input modules are not modified and remain owned by the caller.</para>
+        /// <para>If <paramref name="context"/> has <see cref="Context.UniqueDebugTypes"/> set, composite debug types shared
+        /// by the modules are linked into a single definition, <see cref="LinkStageTiming.DeduplicatedDebugTypeCount"/>
+        /// reports the number of duplicates removed by each stage.</para>
+        /// </remarks>
+        public static NativeModule LinkParallel( Context context, IEnumerable<NativeModule> modules, int workerCount, out IReadOnlyList<LinkStageTiming> stageTimings )
+        {
+            if( context == null )
+            {
+                throw new ArgumentNullException( nameof( context ) );
+            }
+
+            if( modules == null )
+            {
+                throw new ArgumentNullException( nameof( modules ) );
+            }
+
+            var moduleHandles = modules.Select( m => m.ModuleHandle ).ToArray( );
+            if( moduleHandles.Length == 0 )
+            {
+                throw new ArgumentException( "At least one module is required", nameof( modules ) );
+            }
+
+            // the serialize, load and finalize stages plus a merge stage for each level of the tree
+            int mergeLevels = 0;
+            for( int remaining = moduleHandles.Length; remaining > 1; remaining = ( remaining + 1 ) / 2 )
+            {
+                ++mergeLevels;
+            }
+
+            var nativeTimings = new LLVMLinkStageTiming[ 3 + mergeLevels ];
+            var status = NativeMethods.LinkModulesParallel( context.ContextHandle
+                                                          , moduleHandles
+                                                          , ( uint )moduleHandles.Length
+                                                          , ( uint )Math.Max( 1, workerCount )
+                                                          , out LLVMModuleRef modRef
+                                                          , nativeTimings
+                                                          , ( uint )nativeTimings.Length
+                                                          , out uint stageCount
+                                                          , out string errMsg
+                                                          );
+            if( status.Failed )
+            {
+                throw new InternalCodeGeneratorException( errMsg );
+            }
+
+            stageTimings = nativeTimings.Take( ( int )Math.Min( stageCount, ( uint )nativeTimings.Length ) )
+                                        .Select( t => new LinkStageTiming( t ) )
+                                        .ToList( )
+                                        .AsReadOnly( );
+            return context.GetModuleFor( modRef );
         }
 
         /// <summary>Run optimization passes on the module</summary>
@@ -309,6 +406,101 @@ public void Optimize( TargetMachine targetMachine )
             NativeMethods.RunLegacyOptimizer( ModuleHandle, targetMachine.TargetMachineHandle );
         }
 
+        /// <summary>Run optimization passes on the module</summary>
+        /// <param name="targetMachine"><see cref="TargetMachine"/> for use during optimizations</param>
+        /// <param name="options">Options for the optimization</param>
+        /// <remarks>
+        /// Unlike <see cref="Optimize(TargetMachine)"/> this does not use any of the global command line options,
+        /// thus it is safe to optimize modules from different contexts on multiple threads concurrently.
+        /// </remarks>
+        public void Optimize( TargetMachine targetMachine, LegacyOptimizerOptions options )
+        {
+            if( targetMachine == null )
+            {
+                throw new ArgumentNullException( nameof( targetMachine ) );
+            }
+
+            if( options == null )
+            {
+                throw new ArgumentNullException( nameof( options ) );
+            }
+
+            var nativeOptions = options.ToNative( );
+            if( NativeMethods.RunLegacyOptimizerWithOptions( ModuleHandle, targetMachine.TargetMachineHandle, ref nativeOptions, out string errMsg ).Failed )
+            {
+                throw new ArgumentException( errMsg, nameof( options ) );
+            }
+        }
+
+        /// <summary>Runs a new pass manager pipeline on the module, running the function passes on multiple threads</summary>
+        /// <param name="targetMachine"><see cref="TargetMachine"/> for use during optimizations</param>
+        /// <param name="modulePipeline">Textual pipeline run on the whole module first, or <see langword="null"/> for none</param>
+        /// <param name="functionPipeline">Textual list of function passes (e.g. "instcombine,simplifycfg") run on each function, or <see langword="null"/> for none</param>
+        /// <param name="workerCount">Maximum number of threads to run the function passes on</param>
+        /// <remarks>
+        /// The pipelines use the syntax of the LLVM 'opt' tool's -passes option. <paramref name="modulePipeline"/> runs serially,
+        /// so interprocedural passes see the whole module. When <paramref name="workerCount"/> is greater than 1 the function
+        /// definitions are partitioned across that many threads, each with a private copy of its functions, and the optimized
+        /// functions then replace the originals in the module. The result is the same as running the passes serially, however
+        /// any <see cref="Values.Function"/> instances obtained from the module before optimizing are invalid afterwards.
+        /// </remarks>
+        public void Optimize( TargetMachine targetMachine, string modulePipeline, string functionPipeline, int workerCount )
+        {
+            if( targetMachine == null )
+            {
+                throw new ArgumentNullException( nameof( targetMachine ) );
+            }
+
+            // returns true on success
+            if( !NativeMethods.RunPassPipelineParallel( ModuleHandle
+                                                      , targetMachine.TargetMachineHandle
+                                                      , modulePipeline
+                                                      , functionPipeline
+                                                      , LLVMOptVerifierKind.None
+                                                      , ( uint )Math.Max( 1, workerCount )
+                                                      ) )
+            {
+                throw new ArgumentException( "Invalid module or function pass pipeline" );
+            }
+        }
+
+        /// <summary>Runs a new pass manager pipeline on the module, timing each stage of the pipeline</summary>
+        /// <param name="targetMachine"><see cref="TargetMachine"/> for use during optimizations</param>
+        /// <param name="passPipeline">Textual pass pipeline, in the syntax of the LLVM 'opt' tool's -passes option</param>
+        /// <param name="verify">Flag to indicate if the module is verified before and after the pipeline</param>
+        /// <returns>Timing for each stage of the pipeline, in pipeline order</returns>
+        /// <remarks>
+        /// A stage is a top level element of <paramref name="passPipeline"/>, thus groups and aliases, such as
+        /// "function(instcombine,simplifycfg)" or "default&lt;O2&gt;", are timed as a whole. A pipeline that
+        /// starts with a function or CGSCC pass runs all of its passes together, so it is a single stage.
+        /// If <paramref name="verify"/> is true the verification at the start and end are reported as
+        /// stages named "verify".
+        /// </remarks>
+        public IReadOnlyList<PassStageTiming> OptimizeWithTiming( TargetMachine targetMachine, string passPipeline, bool verify )
+        {
+            if( targetMachine == null )
+            {
+                throw new ArgumentNullException( nameof( targetMachine ) );
+            }
+
+            if( string.IsNullOrWhiteSpace( passPipeline ) )
+            {
+                throw new ArgumentException( "Pass pipeline cannot be null, empty or whitespace", nameof( passPipeline ) );
+            }
+
+            var stageTimings = new List<PassStageTiming>( );
+            var verifierKind = verify ? LLVMOptVerifierKind.VerifyInAndOut : LLVMOptVerifierKind.None;
+            NativeMethods.PassTimingCallback callback = ( IntPtr userData, ref LLVMPassTimingRecord record ) => stageTimings.Add( new PassStageTiming( record ) );
+
+            // returns true on success
+            if( !NativeMethods.RunPassPipelineWithTiming( ModuleHandle, targetMachine.TargetMachineHandle, passPipeline, verifierKind, callback, IntPtr.Zero ) )
+            {
+                throw new ArgumentException( "Invalid pass pipeline", nameof( passPipeline ) );
+            }
+
+            return stageTimings.AsReadOnly( );
+        }
+
         /// <summary>Verifies a bit-code module</summary>
         /// <param name="errmsg">Error messages describing any issues found in the bit-code</param>
         /// <returns>true if the verification succeeded and false if not.</returns>
@@ -317,6 +509,77 @@ public bool Verify( out string errmsg )
             return NativeMethods.VerifyModule( ModuleHandle, LLVMVerifierFailureAction.LLVMReturnStatusAction, out errmsg );
         }
 
+        /// <summary>Verifies the functions of the module concurrently</summary>
+        /// <param name="workerCount">Maximum number of threads to use</param>
+        /// <returns>Diagnostics for each failed check, in the order of the functions in the module</returns>
+        /// <remarks>
+        /// The threads only find the broken functions, those are then verified again on the calling thread
+        /// to produce the diagnostics, as printing the values involved updates the <see cref="Context"/>.
+        /// Thus, the module and its <see cref="Context"/> must not be used by any other thread until this
+        /// returns. Only the functions are verified, use
+        /// <see cref="Verify(out string)"/> to also verify the global values and metadata of the module.
+        /// </remarks>
+        public IReadOnlyList<VerifierDiagnostic> VerifyFunctions( int workerCount ) => VerifyFunctions( workerCount, 0 );
+
+        /// <summary>Verifies the functions of the module concurrently, stopping after a maximum number of errors</summary>
+        /// <param name="workerCount">Maximum number of threads to use</param>
+        /// <param name="maxErrors">Maximum number of errors to report, 0 reports all of them</param>
+        /// <returns>Diagnostics for the first <paramref name="maxErrors"/> failed checks, in the order of the functions in the module</returns>
+        /// <remarks>
+        /// Verification stops once <paramref name="maxErrors"/> checks have failed. Thus, checking whether machine
+        /// generated IR is broken doesn't have to produce, and decode, the text for every problem in it.
+        /// </remarks>
+        public IReadOnlyList<VerifierDiagnostic> VerifyFunctions( int workerCount, int maxErrors )
+        {
+            if( maxErrors < 0 )
+            {
+                throw new ArgumentOutOfRangeException( nameof( maxErrors ) );
+            }
+
+            NativeMethods.VerifyModuleFunctionsParallel( ModuleHandle, ( uint )Math.Max( 1, workerCount ), ( uint )maxErrors, out LLVMVerifierDiagnosticsRef diagnosticsHandle );
+            using( diagnosticsHandle )
+            {
+                int count = ( int )NativeMethods.VerifierDiagnosticsGetCount( diagnosticsHandle );
+                if( count == 0 )
+                {
+                    return new List<VerifierDiagnostic>( ).AsReadOnly( );
+                }
+
+                // the text is copied once, then each message is decoded from its slice of it
+                var textPtr = NativeMethods.VerifierDiagnosticsGetText( diagnosticsHandle, out size_t textLength );
+                var text = new byte[ textLength.Pointer.ToInt64( ) ];
+                Marshal.Copy( textPtr, text, 0, text.Length );
+
+                var functions = Functions.ToList( );
+                var instructions = new Dictionary<uint, List<Instruction>>( );
+                var recordsPtr = NativeMethods.VerifierDiagnosticsGetRecords( diagnosticsHandle );
+                int recordSize = Marshal.SizeOf<LLVMVerifierDiagnostic>( );
+                var retVal = new List<VerifierDiagnostic>( count );
+                for( int i = 0; i < count; ++i )
+                {
+                    var record = Marshal.PtrToStructure<LLVMVerifierDiagnostic>( recordsPtr + ( i * recordSize ) );
+                    var function = functions[ ( int )record.FunctionIndex ];
+
+                    Instruction instruction = null;
+                    if( record.InstructionIndex != NoInstructionIndex )
+                    {
+                        if( !instructions.TryGetValue( record.FunctionIndex, out List<Instruction> functionInstructions ) )
+                        {
+                            functionInstructions = function.BasicBlocks.SelectMany( b => b.Instructions ).ToList( );
+                            instructions.Add( record.FunctionIndex, functionInstructions );
+                        }
+
+                        instruction = functionInstructions[ ( int )record.InstructionIndex ];
+                    }
+
+                    string message = Encoding.UTF8.GetString( text, ( int )record.TextOffset.Pointer.ToInt64( ), ( int )record.TextLength.Pointer.ToInt64( ) );
+                    retVal.Add( new VerifierDiagnostic( function, instruction, ( int )record.MessageId, message ) );
+                }
+
+                return retVal.AsReadOnly( );
+            }
+        }
+
         /// <summary>Gets a function by name from this module</summary>
         /// <param name="name">Name of the function to get</param>
         /// <returns>The function or null if not found</returns>
@@ -373,6 +636,47 @@ public bool WriteToTextFile( string path, out string errMsg )
             return NativeMethods.PrintModuleToFile( ModuleHandle, path, out errMsg );
         }
 
+        /// <summary>Writes the bit-code for the module to a stream</summary>
+        /// <param name="stream">Stream to write the bit-code to</param>
+        /// <remarks>
+        /// The bit-code is delivered to <paramref name="stream"/> in chunks, which allows piping it directly into
+        /// compression or network streams. This avoids the copies into a <see cref="MemoryBuffer"/> and a managed
+        /// array, however the peak memory use is still the size of the complete bit-code, as LLVM builds it in an
+        /// internal buffer before any of it is delivered.
+        /// </remarks>
+        public void WriteToStream( Stream stream )
+        {
+            if( stream == null )
+            {
+                throw new ArgumentNullException( nameof( stream ) );
+            }
+
+            var chunk = new byte[ BitcodeChunkSize ];
+            Exception writeException = null;
+            bool WriteChunk( IntPtr userData, IntPtr data, size_t size )
+            {
+                try
+                {
+                    int count = size.Pointer.ToInt32( );
+                    Marshal.Copy( data, chunk, 0, count );
+                    stream.Write( chunk, 0, count );
+                    return true;
+                }
+                catch( Exception ex )
+                {
+                    // exceptions must not propagate through the native code
+                    writeException = ex;
+                    return false;
+                }
+            }
+
+            var status = NativeMethods.WriteBitcodeToCallback( ModuleHandle, WriteChunk, IntPtr.Zero, ( size_t )BitcodeChunkSize );
+            if( status.Failed || writeException != null )
+            {
+                throw new IOException( "Error writing bit-code to stream", writeException );
+            }
+        }
+
         /// <summary>Creates a string representation of the module</summary>
         /// <returns>LLVM textual representation of the module</returns>
         /// <remarks>
@@ -707,7 +1011,7 @@ public static NativeModule LoadFrom( string path, Context context )
                 throw new FileNotFoundException( "Specified bit-code file does not exist", path );
             }
 
-            using( var buffer = new MemoryBuffer( path ) )
+            using( var buffer = MemoryBuffer.MapFile( path ) )
             {
                 return LoadFrom( buffer, context );
             }
@@ -741,9 +1045,67 @@ public static NativeModule LoadFrom( MemoryBuffer buffer, Context context )
                 throw new InternalCodeGeneratorException( errMsg );
             }
 
+            if( context.StripDebugInfoOnLoad )
+            {
+                NativeMethods.StripModuleDebugInfo( modRef );
+            }
+
+            return context.GetModuleFor( modRef );
+        }
+
+        /// <summary>Lazily loads a bit-code module from a memory buffer</summary>
+        /// <param name="buffer">Buffer to load from</param>
+        /// <param name="context">Context to load the module into</param>
+        /// <param name="lazyLoadMetadata">Flag to indicate if function level metadata is also loaded on demand</param>
+        /// <returns>Loaded <see cref="NativeModule"/></returns>
+        /// <remarks>
+        /// Only the global declarations are loaded, the bodies of the functions remain in the bit-code until they are
+        /// materialized with <see cref="GlobalValue.Materialize"/> or <see cref="MaterializeAll"/>. Thus, loading a large
+        /// library just to link in a few functions only pays for parsing the functions that are actually used. On success
+        /// the module takes ownership of <paramref name="buffer"/>, which is then no longer usable.
+        /// </remarks>
+        public static NativeModule LoadLazilyFrom( MemoryBuffer buffer, Context context, bool lazyLoadMetadata = false )
+        {
+            if( buffer == null )
+            {
+                throw new ArgumentNullException( nameof( buffer ) );
+            }
+
+            if( context == null )
+            {
+                throw new ArgumentNullException( nameof( context ) );
+            }
+
+            if( NativeMethods.GetLazyBitcodeModuleInContextEx( context.ContextHandle, buffer.BufferHandle, lazyLoadMetadata, out LLVMModuleRef modRef, out string errMsg ).Failed )
+            {
+                throw new InternalCodeGeneratorException( errMsg );
+            }
+
+            buffer.Detach( );
+
+            // stripping a lazily loaded module also strips functions as they are materialized
+            if( context.StripDebugInfoOnLoad )
+            {
+                NativeMethods.StripModuleDebugInfo( modRef );
+            }
+
             return context.GetModuleFor( modRef );
         }
 
+        /// <summary>Removes all debug information from the module</summary>
+        /// <returns><see langword="true"/> if the module contained any debug information</returns>
+        /// <remarks>Any debug information objects obtained for the module are no longer valid afterwards.</remarks>
+        public bool StripDebugInfo( ) => NativeMethods.StripModuleDebugInfo( ModuleHandle );
+
+        /// <summary>Materializes the bodies of all functions not yet loaded in a lazily loaded module</summary>
+        public void MaterializeAll( )
+        {
+            if( NativeMethods.ModuleMaterializeAll( ModuleHandle, out string errMsg ).Failed )
+            {
+                throw new InternalCodeGeneratorException( errMsg );
+            }
+        }
+
         internal NativeModule( LLVMModuleRef handle )
         {
             ModuleHandle = handle;
@@ -752,6 +1114,14 @@ internal NativeModule( LLVMModuleRef handle )
             Comdats = new ComdatCollection( this );
         }
 
+        // ownership of the native module was transferred elsewhere (i.e. linked into
+        // another module or added to a JIT) so this instance no longer refers to it.
+        internal void Detach( )
+        {
+            Context.RemoveModule( this );
+            ModuleHandle = new LLVMModuleRef( IntPtr.Zero );
+        }
+
         internal static NativeModule FromHandle( LLVMModuleRef nativeHandle )
         {
             var context = Context.GetContextFor( nativeHandle );
@@ -793,5 +1163,11 @@ private void Dispose( bool disposing )
         private readonly ExtensiblePropertyContainer PropertyBag = new ExtensiblePropertyContainer( );
         private readonly Lazy<DebugInfoBuilder> LazyDiBuilder;
         private readonly bool OwnsContext;
+
+        // size of the chunks delivered to managed code when streaming bit-code
+        private const int BitcodeChunkSize = 64 * 1024;
+
+        // LLVMVerifierNoInstruction
+        private const uint NoInstructionIndex = uint.MaxValue;
     }
 }
@@ -200,6 +200,75 @@ internal enum LLVMOptVerifierKind
         VerifyEachPass
     }
 
+    internal struct LLVMVerifierDiagnostic
+    {
+        public readonly uint FunctionIndex;
+        public readonly uint InstructionIndex;
+        public readonly uint MessageId;
+        public readonly size_t TextOffset;
+        public readonly size_t TextLength;
+    }
+
+    internal struct LLVMDITypeInfo
+    {
+        public readonly LLVMMetadataRef Scope;
+        public readonly LLVMMetadataRef File;
+        public readonly LLVMMetadataRef BaseType;
+        public readonly LLVMMetadataRef ExtraData;
+        public readonly LLVMMetadataRef Elements;
+        public readonly LLVMMetadataRef VTableHolder;
+        public readonly LLVMMetadataRef TemplateParams;
+        public readonly IntPtr Name;
+        public readonly size_t NameLength;
+        public readonly IntPtr Identifier;
+        public readonly size_t IdentifierLength;
+        public readonly UInt64 SizeInBits;
+        public readonly UInt64 OffsetInBits;
+        public readonly UInt32 AlignInBits;
+        public readonly UInt32 Line;
+        public readonly UInt32 Flags;
+        public readonly UInt32 Tag;
+        public readonly UInt32 Encoding;
+        public readonly UInt32 RuntimeLang;
+    }
+
+    internal struct LLVMDIMemberDescriptor
+    {
+        public LLVMMetadataRef Type;
+        public LLVMMetadataRef File;
+        public UInt64 SizeInBits;
+        public UInt64 OffsetInBits;
+        public size_t NameOffset;
+        public size_t NameLength;
+        public UInt32 Line;
+        public UInt32 AlignInBits;
+        public UInt32 Flags;
+    }
+
+    internal enum LLVMDwarfEmissionKind
+    {
+        None = 0,
+        Full,
+        LineTablesOnly
+    }
+
+    internal enum LLVMLinkStageKind
+    {
+        Serialize,
+        Load,
+        Merge,
+        Finalize
+    }
+
+    internal struct LLVMLinkStageTiming
+    {
+        public readonly LLVMLinkStageKind Kind;
+        public readonly uint Level;
+        public readonly uint TaskCount;
+        public readonly uint DeduplicatedTypeCount;
+        public readonly double WallTimeInSeconds;
+    }
+
     internal enum LLVMTripleArchType
     {
         UnknownArch,
@@ -384,6 +453,20 @@ internal static partial class NativeMethods
         [DllImport( libraryPath, EntryPoint = "LLVMGetVersionInfo", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         internal static extern void GetVersionInfo( out LLVMVersionInfo pVersionInfo );
 
+        [DllImport( libraryPath, EntryPoint = "LLVMContextSetDiscardValueNames", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern void ContextSetDiscardValueNames( LLVMContextRef C, [MarshalAs( UnmanagedType.Bool )] bool discard );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMContextShouldDiscardValueNames", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        [return: MarshalAs( UnmanagedType.Bool )]
+        internal static extern bool ContextShouldDiscardValueNames( LLVMContextRef C );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMContextSetODRUniquingDebugTypes", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern void ContextSetODRUniquingDebugTypes( LLVMContextRef C, [MarshalAs( UnmanagedType.Bool )] bool enable );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMContextIsODRUniquingDebugTypes", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        [return: MarshalAs( UnmanagedType.Bool )]
+        internal static extern bool ContextIsODRUniquingDebugTypes( LLVMContextRef C );
+
         [DllImport( libraryPath, EntryPoint = "LLVMGetValueID", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         internal static extern int GetValueID( LLVMValueRef @val );
 
@@ -414,6 +497,21 @@ internal static partial class NativeMethods
         [DllImport( libraryPath, EntryPoint = "LLVMVerifyFunctionEx", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         internal static extern LLVMStatus VerifyFunctionEx( LLVMValueRef @Fn, LLVMVerifierFailureAction @Action, [MarshalAs(UnmanagedType.CustomMarshaler, MarshalTypeRef=typeof(StringMarshaler), MarshalCookie="DisposeMessage")] out string @OutMessages );
 
+        [DllImport( libraryPath, EntryPoint = "LLVMVerifyModuleFunctionsParallel", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMStatus VerifyModuleFunctionsParallel( LLVMModuleRef M, uint workerCount, uint maxErrors, out LLVMVerifierDiagnosticsRef outDiagnostics );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMVerifierDiagnosticsGetCount", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern uint VerifierDiagnosticsGetCount( LLVMVerifierDiagnosticsRef diagnostics );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMVerifierDiagnosticsGetRecords", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern IntPtr VerifierDiagnosticsGetRecords( LLVMVerifierDiagnosticsRef diagnostics );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMVerifierDiagnosticsGetText", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern IntPtr VerifierDiagnosticsGetText( LLVMVerifierDiagnosticsRef diagnostics, out size_t length );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMDisposeVerifierDiagnostics", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern void DisposeVerifierDiagnostics( IntPtr diagnostics );
+
         [DllImport( libraryPath, EntryPoint = "LLVMAddAddressSanitizerFunctionPass", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         internal static extern void AddAddressSanitizerFunctionPass( LLVMPassManagerRef @PM );
 
@@ -478,6 +576,9 @@ internal static partial class NativeMethods
         [DllImport( libraryPath, EntryPoint = "LLVMMetadataReplaceAllUsesWith", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         internal static extern void MetadataReplaceAllUsesWith( LLVMMetadataRef @MD, LLVMMetadataRef @New );
 
+        [DllImport( libraryPath, EntryPoint = "LLVMMetadataReplaceAllTemporaries", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern void MetadataReplaceAllTemporaries( [In] LLVMMetadataRef[ ] temporaries, [In] LLVMMetadataRef[ ] replacements, size_t count );
+
         // Added to LLVM-C API in LLVM 5.0.0
         [DllImport( libraryPath, EntryPoint = "LLVMMetadataAsValue", CallingConvention = CallingConvention.Cdecl )]
         internal static extern LLVMValueRef MetadataAsValue( LLVMContextRef context, LLVMMetadataRef metadataRef );
@@ -500,7 +601,13 @@ internal static partial class NativeMethods
         internal static extern void DIBuilderFinalize( LLVMDIBuilderRef @d );
 
         [DllImport( libraryPath, EntryPoint = "LLVMDIBuilderCreateCompileUnit", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        internal static extern LLVMMetadataRef DIBuilderCreateCompileUnit( LLVMDIBuilderRef @D, UInt32 @Language, [MarshalAs( UnmanagedType.LPStr )] string @File, [MarshalAs( UnmanagedType.LPStr )] string @Dir, [MarshalAs( UnmanagedType.LPStr )] string @Producer, int @Optimized, [MarshalAs( UnmanagedType.LPStr )] string @Flags, UInt32 @RuntimeVersion );
+        internal static extern LLVMMetadataRef DIBuilderCreateCompileUnit( LLVMDIBuilderRef @D, UInt32 @Language, [MarshalAs( UnmanagedType.LPStr )] string @File, [MarshalAs( UnmanagedType.LPStr )] string @Dir, [MarshalAs( UnmanagedType.LPStr )] string @Producer, int @Optimized, [MarshalAs( UnmanagedType.LPStr )] string @Flags, UInt32 @RuntimeVersion, LLVMDwarfEmissionKind @EmissionKind, [MarshalAs( UnmanagedType.LPStr )] string @SplitName );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMDICompileUnitGetEmissionKind", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMDwarfEmissionKind DICompileUnitGetEmissionKind( LLVMMetadataRef compileUnit );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMDICompileUnitGetSplitDebugFilename", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern IntPtr DICompileUnitGetSplitDebugFilename( LLVMMetadataRef compileUnit, out size_t length );
 
         [DllImport( libraryPath, EntryPoint = "LLVMDIBuilderCreateFile", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         internal static extern LLVMMetadataRef DIBuilderCreateFile( LLVMDIBuilderRef @D, [MarshalAs( UnmanagedType.LPStr )] string @File, [MarshalAs( UnmanagedType.LPStr )] string @Dir );
@@ -538,6 +645,9 @@ internal static partial class NativeMethods
         [DllImport( libraryPath, EntryPoint = "LLVMDIBuilderCreateStructType", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         internal static extern LLVMMetadataRef DIBuilderCreateStructType( LLVMDIBuilderRef @D, LLVMMetadataRef @Scope, [MarshalAs( UnmanagedType.LPStr )] string @Name, LLVMMetadataRef @File, UInt32 @Line, UInt64 @SizeInBits, UInt32 @AlignInBits, UInt32 @Flags, LLVMMetadataRef @DerivedFrom, LLVMMetadataRef @ElementTypes );
 
+        [DllImport( libraryPath, EntryPoint = "LLVMDIBuilderCreateCompositeTypeWithMembers", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMMetadataRef DIBuilderCreateCompositeTypeWithMembers( LLVMDIBuilderRef @D, UInt32 @Tag, LLVMMetadataRef @Scope, [MarshalAs( UnmanagedType.LPStr )] string @Name, LLVMMetadataRef @File, UInt32 @Line, UInt64 @SizeInBits, UInt32 @AlignInBits, UInt32 @Flags, LLVMMetadataRef @DerivedFrom, [In] LLVMDIMemberDescriptor[ ] @Members, size_t @MemberCount, [In] byte[ ] @NameBlob );
+
         [DllImport( libraryPath, EntryPoint = "LLVMDIBuilderCreateUnionType", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         internal static extern LLVMMetadataRef DIBuilderCreateUnionType( LLVMDIBuilderRef @D, LLVMMetadataRef @Scope, [MarshalAs( UnmanagedType.LPStr )] string @Name, LLVMMetadataRef @File, UInt32 @Line, UInt64 @SizeInBits, UInt32 @AlignInBits, UInt32 @Flags, LLVMMetadataRef @ElementTypes );
 
@@ -590,8 +700,7 @@ internal static partial class NativeMethods
         internal static extern LLVMValueRef DIBuilderInsertValueBefore( LLVMDIBuilderRef Dref, /*llvm::Value **/LLVMValueRef Val, UInt64 Offset, /*DILocalVariable **/ LLVMMetadataRef VarInfo, /*DIExpression **/ LLVMMetadataRef Expr, /*const DILocation **/ LLVMMetadataRef DL, /*Instruction **/ LLVMValueRef InsertBefore );
 
         [DllImport( libraryPath, EntryPoint = "LLVMMetadataAsString", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        [return: MarshalAs(UnmanagedType.CustomMarshaler, MarshalTypeRef=typeof(StringMarshaler), MarshalCookie="DisposeMessage")]
-        internal static extern string MetadataAsString( LLVMMetadataRef descriptor );
+        internal static extern IntPtr MetadataAsString( LLVMMetadataRef descriptor, out size_t length );
 
         [DllImport( libraryPath, EntryPoint = "LLVMMDNodeReplaceAllUsesWith", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         internal static extern void MDNodeReplaceAllUsesWith( LLVMMetadataRef oldDescriptor, LLVMMetadataRef newDescriptor );
@@ -606,8 +715,7 @@ internal static partial class NativeMethods
         internal static extern LLVMMetadataRef DILocation( LLVMContextRef context, UInt32 Line, UInt32 Column, LLVMMetadataRef scope, LLVMMetadataRef InlinedAt );
 
         [DllImport( libraryPath, EntryPoint = "LLVMGetModuleName", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        [return: MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ))]
-        internal static extern string GetModuleName( LLVMModuleRef module );
+        internal static extern IntPtr GetModuleName( LLVMModuleRef module, out size_t length );
 
         [DllImport( libraryPath, EntryPoint = "LLVMIsTemporary", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         [return: MarshalAs( UnmanagedType.Bool )]
@@ -626,8 +734,7 @@ internal static partial class NativeMethods
         internal static extern bool IsUniqued( LLVMMetadataRef M );
 
         [DllImport( libraryPath, EntryPoint = "LLVMGetMDStringText", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        [return: MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ) )]
-        internal static extern string GetMDStringText( LLVMMetadataRef M, out UInt32 len );
+        internal static extern IntPtr GetMDStringText( LLVMMetadataRef M, out UInt32 len );
 
         [DllImport( libraryPath, EntryPoint = "LLVMGetGlobalAlias", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         internal static extern LLVMValueRef GetGlobalAlias( LLVMModuleRef module, [MarshalAs( UnmanagedType.LPStr )] string name );
@@ -661,8 +768,13 @@ internal static partial class NativeMethods
         internal static extern LLVMMetadataRef DITypeGetScope( LLVMMetadataRef typeRef );
 
         [DllImport( libraryPath, EntryPoint = "LLVMDITypeGetName", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        [return: MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ) )]
-        internal static extern string DITypeGetName( LLVMMetadataRef typeRef );
+        internal static extern IntPtr DITypeGetName( LLVMMetadataRef typeRef, out size_t length );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMDITypeGetInfo", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern void DITypeGetInfo( LLVMMetadataRef typeRef, out LLVMDITypeInfo info );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMDITypeGetInfoArray", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern void DITypeGetInfoArray( [In] LLVMMetadataRef[ ] types, size_t count, [Out] LLVMDITypeInfo[ ] infos );
 
         [DllImport( libraryPath, EntryPoint = "LLVMDIScopeGetFile", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         internal static extern LLVMMetadataRef DIScopeGetFile( LLVMMetadataRef scope );
@@ -671,12 +783,10 @@ internal static partial class NativeMethods
         internal static extern UInt32 GetArgumentIndex( LLVMValueRef Val );
 
         [DllImport( libraryPath, EntryPoint = "LLVMGetDIFileName", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        [return: MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ) )]
-        internal static extern string GetDIFileName( LLVMMetadataRef /*DIFile*/ file );
+        internal static extern IntPtr GetDIFileName( LLVMMetadataRef /*DIFile*/ file, out size_t length );
 
         [DllImport( libraryPath, EntryPoint = "LLVMGetDIFileDirectory", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        [return: MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ) )]
-        internal static extern string GetDIFileDirectory( LLVMMetadataRef /*DIFile*/ file );
+        internal static extern IntPtr GetDIFileDirectory( LLVMMetadataRef /*DIFile*/ file, out size_t length );
 
         [DllImport( libraryPath, EntryPoint = "LLVMGetNodeContext", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         internal static extern LLVMContextRef GetNodeContext( LLVMMetadataRef /*MDNode*/ node );
@@ -712,6 +822,38 @@ internal static partial class NativeMethods
         [return: MarshalAs( UnmanagedType.Bool )]
         internal static extern bool RunPassPipeline( LLVMContextRef context, LLVMModuleRef M, LLVMTargetMachineRef TM, [MarshalAs( UnmanagedType.LPStr )] string passPipeline, LLVMOptVerifierKind VK, [MarshalAs( UnmanagedType.Bool )] bool ShouldPreserveAssemblyUseListOrder, [MarshalAs( UnmanagedType.Bool )] bool ShouldPreserveBitcodeUseListOrder );
 
+        [DllImport( libraryPath, EntryPoint = "LLVMCreatePassPipeline", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMPassPipelineRef CreatePassPipeline( LLVMTargetMachineRef TM, [MarshalAs( UnmanagedType.LPStr )] string passPipeline, LLVMOptVerifierKind VK );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMPassPipelineRun", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern void PassPipelineRun( LLVMPassPipelineRef pipeline, LLVMModuleRef M );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMDisposePassPipeline", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern void DisposePassPipeline( IntPtr pipeline );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMRunPassPipelineParallel", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        [return: MarshalAs( UnmanagedType.Bool )]
+        internal static extern bool RunPassPipelineParallel( LLVMModuleRef M, LLVMTargetMachineRef TM, [MarshalAs( UnmanagedType.LPStr )] string modulePipeline, [MarshalAs( UnmanagedType.LPStr )] string functionPipeline, LLVMOptVerifierKind VK, UInt32 workerCount );
+
+        [UnmanagedFunctionPointer( CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal delegate void PassTimingCallback( IntPtr userData, [In] ref LLVMPassTimingRecord record );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMRunPassPipelineWithTiming", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        [return: MarshalAs( UnmanagedType.Bool )]
+        internal static extern bool RunPassPipelineWithTiming( LLVMModuleRef M, LLVMTargetMachineRef TM, [MarshalAs( UnmanagedType.LPStr )] string passPipeline, LLVMOptVerifierKind VK, PassTimingCallback callback, IntPtr userData );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMCreateInstrumentedPassPipeline", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMPassPipelineRef CreateInstrumentedPassPipeline( LLVMTargetMachineRef TM, [MarshalAs( UnmanagedType.LPStr )] string passPipeline, LLVMOptVerifierKind VK );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMPassPipelineGetTimingRecords", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern uint PassPipelineGetTimingRecords( LLVMPassPipelineRef pipeline, [Out] LLVMPassTimingRecord[ ] records, uint capacity );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMPassPipelineResetTiming", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern void PassPipelineResetTiming( LLVMPassPipelineRef pipeline );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMTargetMachineEmitPartitionsToMemoryBuffers", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMStatus TargetMachineEmitPartitionsToMemoryBuffers( LLVMTargetMachineRef T, LLVMModuleRef M, UInt32 partitionCount, LLVMCodeGenFileType codegen, [Out] LLVMMemoryBufferRef[ ] outBuffers, [MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ), MarshalCookie = "DisposeMessage" )] out string ErrorMessage );
+
         [DllImport( libraryPath, EntryPoint = "LLVMInitializeCodeGenForOpt", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         internal static extern void InitializeCodeGenForOpt( LLVMPassRegistryRef R );
 
@@ -721,6 +863,9 @@ internal static partial class NativeMethods
         [DllImport( libraryPath, EntryPoint = "LLVMRunLegacyOptimizer", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         internal static extern void RunLegacyOptimizer( LLVMModuleRef Mref, LLVMTargetMachineRef TMref );
 
+        [DllImport( libraryPath, EntryPoint = "LLVMRunLegacyOptimizerWithOptions", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMStatus RunLegacyOptimizerWithOptions( LLVMModuleRef Mref, LLVMTargetMachineRef TMref, [In] ref LLVMLegacyOptimizerOptions options, [MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ), MarshalCookie = "DisposeMessage" )] out string errorMessage );
+
         [DllImport( libraryPath, EntryPoint = "LLVMParseTriple", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         internal static extern LLVMTripleRef ParseTriple( [MarshalAs( UnmanagedType.LPStr )] string triple );
 
@@ -757,36 +902,28 @@ internal static partial class NativeMethods
         internal static extern LLVMTripleObjectFormatType TripleGetObjectFormatType( LLVMTripleRef triple );
 
         [DllImport( libraryPath, EntryPoint = "LLVMTripleAsString", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        [return: MarshalAs(UnmanagedType.CustomMarshaler, MarshalTypeRef=typeof(StringMarshaler), MarshalCookie="DisposeMessage")]
-        internal static extern string TripleAsString( LLVMTripleRef triple, [MarshalAs( UnmanagedType.U1 )]bool normalize );
+        internal static extern IntPtr TripleAsString( LLVMTripleRef triple, [MarshalAs( UnmanagedType.U1 )]bool normalize, out size_t length );
 
         [DllImport( libraryPath, EntryPoint = "LLVMTripleGetArchTypeName", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        [return: MarshalAs(UnmanagedType.CustomMarshaler, MarshalTypeRef=typeof(StringMarshaler), MarshalCookie="DisposeMessage")]
-        internal static extern string TripleGetArchTypeName( LLVMTripleArchType type );
+        internal static extern IntPtr TripleGetArchTypeName( LLVMTripleArchType type, out size_t length );
 
         [DllImport( libraryPath, EntryPoint = "LLVMTripleGetSubArchTypeName", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        [return: MarshalAs(UnmanagedType.CustomMarshaler, MarshalTypeRef=typeof(StringMarshaler), MarshalCookie="DisposeMessage")]
-        internal static extern string TripleGetSubArchTypeName( LLVMTripleSubArchType type );
+        internal static extern IntPtr TripleGetSubArchTypeName( LLVMTripleSubArchType type, out size_t length );
 
         [DllImport( libraryPath, EntryPoint = "LLVMTripleGetVendorTypeName", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        [return: MarshalAs(UnmanagedType.CustomMarshaler, MarshalTypeRef=typeof(StringMarshaler), MarshalCookie="DisposeMessage")]
-        internal static extern string TripleGetVendorTypeName( LLVMTripleVendorType vendor );
+        internal static extern IntPtr TripleGetVendorTypeName( LLVMTripleVendorType vendor, out size_t length );
 
         [DllImport( libraryPath, EntryPoint = "LLVMTripleGetOsTypeName", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        [return: MarshalAs(UnmanagedType.CustomMarshaler, MarshalTypeRef=typeof(StringMarshaler), MarshalCookie="DisposeMessage")]
-        internal static extern string TripleGetOsTypeName( LLVMTripleOSType osType );
+        internal static extern IntPtr TripleGetOsTypeName( LLVMTripleOSType osType, out size_t length );
 
         [DllImport( libraryPath, EntryPoint = "LLVMTripleGetEnvironmentTypeName", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        [return: MarshalAs(UnmanagedType.CustomMarshaler, MarshalTypeRef=typeof(StringMarshaler), MarshalCookie="DisposeMessage")]
-        internal static extern string TripleGetEnvironmentTypeName( LLVMTripleEnvironmentType environmentType );
+        internal static extern IntPtr TripleGetEnvironmentTypeName( LLVMTripleEnvironmentType environmentType, out size_t length );
 
         [DllImport( libraryPath, EntryPoint = "LLVMTripleGetObjectFormatTypeName", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        [return: MarshalAs(UnmanagedType.CustomMarshaler, MarshalTypeRef=typeof(StringMarshaler), MarshalCookie="DisposeMessage")]
-        internal static extern string TripleGetObjectFormatTypeName( LLVMTripleObjectFormatType environmentType );
+        internal static extern IntPtr TripleGetObjectFormatTypeName( LLVMTripleObjectFormatType environmentType, out size_t length );
 
         [DllImport( libraryPath, EntryPoint = "LLVMNormalizeTriple", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        [return: MarshalAs(UnmanagedType.CustomMarshaler, MarshalTypeRef=typeof(StringMarshaler), MarshalCookie="DisposeMessage")]
-        internal static extern string NormalizeTriple( [MarshalAs( UnmanagedType.LPStr )] string triple );
+        internal static extern IntPtr NormalizeTriple( [MarshalAs( UnmanagedType.LPStr )] string triple, out size_t length );
 
         [UnmanagedFunctionPointer( CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         [return: MarshalAs( UnmanagedType.Bool )]
@@ -796,7 +933,7 @@ internal static partial class NativeMethods
         internal static extern void ModuleEnumerateComdats( LLVMModuleRef module, ComdatIteratorCallback callback );
 
         [DllImport( libraryPath, EntryPoint = "LLVMModuleInsertOrUpdateComdat", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        internal static extern LLVMComdatRef ModuleInsertOrUpdateComdat( LLVMModuleRef module, [MarshalAs( UnmanagedType.LPStr )] string name, LLVMComdatSelectionKind kind );
+        internal static extern LLVMComdatRef ModuleInsertOrUpdateComdat( LLVMModuleRef module, [MarshalAs( UnmanagedType.LPUTF8Str )] string name, LLVMComdatSelectionKind kind );
 
         [DllImport( libraryPath, EntryPoint = "LLVMModuleComdatRemove", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
         internal static extern void ModuleComdatRemove( LLVMModuleRef module, LLVMComdatRef comdatRef );
@@ -817,17 +954,103 @@ internal static partial class NativeMethods
         internal static extern void ComdatSetKind( LLVMComdatRef comdatRef, LLVMComdatSelectionKind kind );
 
         [DllImport( libraryPath, EntryPoint = "LLVMComdatGetName", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
-        [return: MarshalAs(UnmanagedType.CustomMarshaler, MarshalTypeRef=typeof(StringMarshaler), MarshalCookie="DisposeMessage")]
-        internal static extern string ComdatGetName( LLVMComdatRef comdatRef );
+        internal static extern IntPtr ComdatGetName( LLVMComdatRef comdatRef, out size_t length );
 
         [DllImport( libraryPath, EntryPoint = "LLVMAttributeToString", CallingConvention = CallingConvention.Cdecl )]
-        [return: MarshalAs(UnmanagedType.CustomMarshaler, MarshalTypeRef=typeof(StringMarshaler), MarshalCookie="DisposeMessage")]
-        internal static extern string AttributeToString( LLVMAttributeRef attribute );
+        internal static extern IntPtr AttributeToString( LLVMAttributeRef attribute, out size_t length );
 
         [DllImport( libraryPath, EntryPoint = "LLVMDIGlobalVarExpGetVariable", CallingConvention = CallingConvention.Cdecl )]
         internal static extern LLVMMetadataRef DIGlobalVarExpGetVariable( LLVMMetadataRef metadataHandle );
 
         [DllImport( libraryPath, EntryPoint = "LLVMGlobalVariableAddDebugExpression", CallingConvention = CallingConvention.Cdecl )]
         internal static extern void GlobalVariableAddDebugExpression( LLVMValueRef variable, LLVMMetadataRef metadataHandle );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMCreateObjectCache", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMObjectCacheRef CreateObjectCache( [MarshalAs( UnmanagedType.LPStr )] string cacheDirectory, UInt64 maxSizeInBytes, [MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ), MarshalCookie = "DisposeMessage" )] out string errorMessage );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMDisposeObjectCache", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern void DisposeObjectCache( IntPtr cache );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMObjectCacheCompileModule", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMStatus ObjectCacheCompileModule( LLVMObjectCacheRef cache, LLVMModuleRef M, LLVMTargetMachineRef TM, [MarshalAs( UnmanagedType.LPStr )] string passPipeline, LLVMOptVerifierKind VK, out LLVMMemoryBufferRef outBuffer, [MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ), MarshalCookie = "DisposeMessage" )] out string errorMessage );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMObjectCacheGetStats", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern void ObjectCacheGetStats( LLVMObjectCacheRef cache, out LLVMObjectCacheStats stats );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMOrcCreateNativeInstance", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMOrcJITStackRef OrcCreateNativeInstance( [MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ), MarshalCookie = "DisposeMessage" )] out string errorMessage );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMOrcAddLazilyCompiledModule", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMOrcModuleHandle OrcAddLazilyCompiledModule( LLVMOrcJITStackRef jitStack, LLVMModuleRef M );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMOrcAddEagerlyCompiledModule", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMOrcModuleHandle OrcAddEagerlyCompiledModule( LLVMOrcJITStackRef jitStack, LLVMModuleRef M );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMFunctionGetInstructionInfos", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern uint FunctionGetInstructionInfos( LLVMValueRef function, [Out] LLVMInstructionInfo[ ] infos, uint capacity );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMModuleGetInstructionInfos", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern uint ModuleGetInstructionInfos( LLVMModuleRef module, [Out] LLVMInstructionInfo[ ] infos, uint capacity );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMGetOperandsBulk", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern uint GetOperandsBulk( LLVMValueRef[ ] values, uint valueCount, [Out] uint[ ] offsets, [Out] LLVMValueRef[ ] results, uint capacity );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMGetUsersBulk", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern uint GetUsersBulk( LLVMValueRef[ ] values, uint valueCount, [Out] uint[ ] offsets, [Out] LLVMValueRef[ ] results, uint capacity );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMGetLazyBitcodeModuleInContextEx", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMStatus GetLazyBitcodeModuleInContextEx( LLVMContextRef context, LLVMMemoryBufferRef MemBuf, [MarshalAs( UnmanagedType.Bool )] bool lazyLoadMetadata, out LLVMModuleRef outModule, [MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ), MarshalCookie = "DisposeMessage" )] out string errorMessage );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMGlobalValueIsMaterializable", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        [return: MarshalAs( UnmanagedType.Bool )]
+        internal static extern bool GlobalValueIsMaterializable( LLVMValueRef globalValue );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMGlobalValueMaterialize", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMStatus GlobalValueMaterialize( LLVMValueRef globalValue, [MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ), MarshalCookie = "DisposeMessage" )] out string errorMessage );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMModuleMaterializeAll", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMStatus ModuleMaterializeAll( LLVMModuleRef module, [MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ), MarshalCookie = "DisposeMessage" )] out string errorMessage );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMStripModuleDebugInfo", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        [return: MarshalAs( UnmanagedType.Bool )]
+        internal static extern bool StripModuleDebugInfo( LLVMModuleRef module );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMCreateMemoryBufferWithMappedFile", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMStatus CreateMemoryBufferWithMappedFile( [MarshalAs( UnmanagedType.LPStr )] string path, out LLVMMemoryBufferRef outBuffer, [MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ), MarshalCookie = "DisposeMessage" )] out string errorMessage );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMMemoryBufferIsMemoryMapped", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        [return: MarshalAs( UnmanagedType.Bool )]
+        internal static extern bool MemoryBufferIsMemoryMapped( LLVMMemoryBufferRef buffer );
+
+        [UnmanagedFunctionPointer( CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        [return: MarshalAs( UnmanagedType.Bool )]
+        internal delegate bool BitcodeWriteCallback( IntPtr userData, IntPtr data, size_t size );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMWriteBitcodeToCallback", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMStatus WriteBitcodeToCallback( LLVMModuleRef module, BitcodeWriteCallback callback, IntPtr userData, size_t chunkSize );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMLinkModulesParallel", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMStatus LinkModulesParallel( LLVMContextRef destContext, LLVMModuleRef[ ] modules, uint moduleCount, uint workerCount, out LLVMModuleRef outModule, [Out] LLVMLinkStageTiming[ ] stageTimings, uint stageCapacity, out uint stageCount, [MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ), MarshalCookie = "DisposeMessage" )] out string errorMessage );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMCreateThinLtoCodeGen", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMThinLtoCodeGenRef CreateThinLtoCodeGen( LLVMTargetMachineRef TM, uint optLevel );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMDisposeThinLtoCodeGen", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern void DisposeThinLtoCodeGen( IntPtr codeGen );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMThinLtoAddModule", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMStatus ThinLtoAddModule( LLVMThinLtoCodeGenRef codeGen, LLVMModuleRef M, [MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ), MarshalCookie = "DisposeMessage" )] out string errorMessage );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMThinLtoPreserveSymbol", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern void ThinLtoPreserveSymbol( LLVMThinLtoCodeGenRef codeGen, [MarshalAs( UnmanagedType.LPStr )] string name );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMThinLtoRun", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMStatus ThinLtoRun( LLVMThinLtoCodeGenRef codeGen, [MarshalAs( UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof( StringMarshaler ), MarshalCookie = "DisposeMessage" )] out string errorMessage );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMThinLtoGetObjectCount", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern uint ThinLtoGetObjectCount( LLVMThinLtoCodeGenRef codeGen );
+
+        [DllImport( libraryPath, EntryPoint = "LLVMThinLtoGetObject", CallingConvention = CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true )]
+        internal static extern LLVMMemoryBufferRef ThinLtoGetObject( LLVMThinLtoCodeGenRef codeGen, uint index );
     }
 }
@@ -0,0 +1,10 @@
+﻿namespace Llvm.NET.Native
+{
+    internal struct LLVMInstructionInfo
+    {
+        public readonly LLVMValueRef Instruction;
+        public readonly int ValueID;
+        public readonly LLVMOpcode Opcode;
+        public readonly uint OperandCount;
+    }
+}
@@ -0,0 +1,28 @@
+﻿using System.Runtime.InteropServices;
+
+namespace Llvm.NET.Native
+{
+    [StructLayout( LayoutKind.Sequential, CharSet = CharSet.Ansi )]
+    internal struct LLVMLegacyOptimizerOptions
+    {
+        [MarshalAs( UnmanagedType.LPStr )]
+        public string Passes;
+        [MarshalAs( UnmanagedType.Bool )]
+        public bool DisableUnitAtATime;
+        [MarshalAs( UnmanagedType.Bool )]
+        public bool DisableLoopUnrolling;
+        [MarshalAs( UnmanagedType.Bool )]
+        public bool DisableLoopVectorization;
+        [MarshalAs( UnmanagedType.Bool )]
+        public bool DisableSLPVectorization;
+        [MarshalAs( UnmanagedType.Bool )]
+        public bool DisableSimplifyLibCalls;
+        [MarshalAs( UnmanagedType.Bool )]
+        public bool EnableCoroutines;
+        [MarshalAs( UnmanagedType.Bool )]
+        public bool DiscardValueNames;
+        [MarshalAs( UnmanagedType.Bool )]
+        public bool PassRemarksWithHotness;
+        public uint WorkerCount;
+    }
+}
@@ -0,0 +1,35 @@
+﻿using System;
+using System.Security;
+
+namespace Llvm.NET.Native
+{
+    // typedef struct LLVMOpaqueObjectCache* LLVMObjectCacheRef;
+    [SecurityCritical]
+    internal class LLVMObjectCacheRef
+        : SafeHandleNullIsInvalid
+    {
+        internal LLVMObjectCacheRef( )
+            : base( true )
+        {
+        }
+
+        internal LLVMObjectCacheRef( IntPtr handle, bool owner )
+            : base( owner )
+        {
+            SetHandle( handle );
+        }
+
+        [System.Diagnostics.CodeAnalysis.SuppressMessage( "Microsoft.Performance", "CA1811:AvoidUncalledPrivateCode", Justification = "Required for marshaling support (used via reflection)" )]
+        internal LLVMObjectCacheRef( IntPtr handle )
+            : this( handle, false )
+        {
+        }
+
+        [SecurityCritical]
+        protected override bool ReleaseHandle( )
+        {
+            NativeMethods.DisposeObjectCache( handle );
+            return true;
+        }
+    }
+}
@@ -0,0 +1,10 @@
+﻿namespace Llvm.NET.Native
+{
+    internal struct LLVMObjectCacheStats
+    {
+        public readonly ulong Hits;
+        public readonly ulong Misses;
+        public readonly ulong Evictions;
+        public readonly ulong SizeInBytes;
+    }
+}
@@ -0,0 +1,35 @@
+﻿using System;
+using System.Security;
+
+namespace Llvm.NET.Native
+{
+    // typedef struct LLVMOpaquePassPipeline* LLVMPassPipelineRef;
+    [SecurityCritical]
+    internal class LLVMPassPipelineRef
+        : SafeHandleNullIsInvalid
+    {
+        internal LLVMPassPipelineRef( )
+            : base( true )
+        {
+        }
+
+        internal LLVMPassPipelineRef( IntPtr handle, bool owner )
+            : base( owner )
+        {
+            SetHandle( handle );
+        }
+
+        [System.Diagnostics.CodeAnalysis.SuppressMessage( "Microsoft.Performance", "CA1811:AvoidUncalledPrivateCode", Justification = "Required for marshaling support (used via reflection)" )]
+        internal LLVMPassPipelineRef( IntPtr handle )
+            : this( handle, false )
+        {
+        }
+
+        [SecurityCritical]
+        protected override bool ReleaseHandle( )
+        {
+            NativeMethods.DisposePassPipeline( handle );
+            return true;
+        }
+    }
+}
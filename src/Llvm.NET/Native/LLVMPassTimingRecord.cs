@@ -0,0 +1,15 @@
+﻿using System;
+using System.Runtime.InteropServices;
+
+namespace Llvm.NET.Native
+{
+    internal struct LLVMPassTimingRecord
+    {
+        public string PassName => Marshal.PtrToStringAnsi( PassNamePtr );
+
+        public readonly IntPtr PassNamePtr;
+        public readonly double WallTimeInSeconds;
+        public readonly ulong InstructionCountBefore;
+        public readonly ulong InstructionCountAfter;
+    }
+}
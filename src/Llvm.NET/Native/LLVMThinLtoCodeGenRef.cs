@@ -0,0 +1,35 @@
+﻿using System;
+using System.Security;
+
+namespace Llvm.NET.Native
+{
+    // typedef struct LLVMOpaqueThinLtoCodeGen* LLVMThinLtoCodeGenRef;
+    [SecurityCritical]
+    internal class LLVMThinLtoCodeGenRef
+        : SafeHandleNullIsInvalid
+    {
+        internal LLVMThinLtoCodeGenRef( )
+            : base( true )
+        {
+        }
+
+        internal LLVMThinLtoCodeGenRef( IntPtr handle, bool owner )
+            : base( owner )
+        {
+            SetHandle( handle );
+        }
+
+        [System.Diagnostics.CodeAnalysis.SuppressMessage( "Microsoft.Performance", "CA1811:AvoidUncalledPrivateCode", Justification = "Required for marshaling support (used via reflection)" )]
+        internal LLVMThinLtoCodeGenRef( IntPtr handle )
+            : this( handle, false )
+        {
+        }
+
+        [SecurityCritical]
+        protected override bool ReleaseHandle( )
+        {
+            NativeMethods.DisposeThinLtoCodeGen( handle );
+            return true;
+        }
+    }
+}
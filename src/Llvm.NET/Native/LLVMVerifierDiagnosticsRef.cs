@@ -0,0 +1,35 @@
+﻿using System;
+using System.Security;
+
+namespace Llvm.NET.Native
+{
+    // typedef struct LLVMOpaqueVerifierDiagnostics* LLVMVerifierDiagnosticsRef;
+    [SecurityCritical]
+    internal class LLVMVerifierDiagnosticsRef
+        : SafeHandleNullIsInvalid
+    {
+        internal LLVMVerifierDiagnosticsRef( )
+            : base( true )
+        {
+        }
+
+        internal LLVMVerifierDiagnosticsRef( IntPtr handle, bool owner )
+            : base( owner )
+        {
+            SetHandle( handle );
+        }
+
+        [System.Diagnostics.CodeAnalysis.SuppressMessage( "Microsoft.Performance", "CA1811:AvoidUncalledPrivateCode", Justification = "Required for marshaling support (used via reflection)" )]
+        internal LLVMVerifierDiagnosticsRef( IntPtr handle )
+            : this( handle, false )
+        {
+        }
+
+        [SecurityCritical]
+        protected override bool ReleaseHandle( )
+        {
+            NativeMethods.DisposeVerifierDiagnostics( handle );
+            return true;
+        }
+    }
+}
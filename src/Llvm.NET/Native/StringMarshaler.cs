@@ -1,6 +1,7 @@
 ﻿using System;
 using System.Diagnostics.CodeAnalysis;
 using System.Runtime.InteropServices;
+using System.Text;
 using System.Text.RegularExpressions;
 
 namespace Llvm.NET.Native
@@ -40,8 +41,42 @@ public IntPtr MarshalManagedToNative( object ManagedObj )
         public object MarshalNativeToManaged( IntPtr pNativeData )
             => NormalizeLineEndings( pNativeData );
 
+        // Converts a string borrowed from LLVM as a pointer and length. Such strings
+        // are not terminated and are owned by the native code so they are copied
+        // here without any cleanup. This is for text LLVM prints, which may span
+        // multiple lines, use FromBorrowedName() for names and other identifiers.
+        internal static string FromBorrowed( IntPtr llvmString, size_t length )
+            => NormalizeLineEndings( FromBorrowedName( llvmString, length ) );
+
+        // Converts a name borrowed from LLVM as a pointer and length, as-is. Unlike
+        // FromBorrowed() the line endings are not normalized, so the name round trips
+        // exactly.
+        internal static string FromBorrowedName( IntPtr llvmString, size_t length )
+        {
+            int len = length;
+            if( llvmString == IntPtr.Zero || len == 0 )
+            {
+                return string.Empty;
+            }
+
+            // names are frequently retrieved, so the bytes are decoded from a buffer
+            // reused by each thread rather than allocating one for every call.
+            if( DecodeBuffer == null || DecodeBuffer.Length < len )
+            {
+                DecodeBuffer = new byte[ Math.Max( len, MinDecodeBufferSize ) ];
+            }
+
+            Marshal.Copy( llvmString, DecodeBuffer, 0, len );
+            return Encoding.UTF8.GetString( DecodeBuffer, 0, len );
+        }
+
         private Action<IntPtr> NativeDisposer;
 
+        private const int MinDecodeBufferSize = 256;
+
+        [ThreadStatic]
+        private static byte[ ] DecodeBuffer;
+
         // LLVM doesn't use environment/OS specific line endings, so this will
         // normalize the line endings from strings provided by LLVM into the current
         // environment's normal format.
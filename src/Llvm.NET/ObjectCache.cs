@@ -0,0 +1,101 @@
+﻿using System;
+using Llvm.NET.Native;
+
+namespace Llvm.NET
+{
+    /// <summary>Content addressed on disk cache of compiled object files</summary>
+    /// <remarks>
+    /// <para>Entries are keyed on a hash of the module's bit-code, the target machine's triple, CPU, features and
+    /// code generation options, and the optimization pass pipeline. Thus, compiling a module that is unchanged
+    /// since it was last compiled, with the same options, reads the object file from the cache instead of running
+    /// the optimizer and code generator.</para>
+    /// <para>The least recently used entries are evicted whenever the total size of the cache exceeds the maximum
+    /// size. A cache is safe to share across threads, and the directory may be shared by multiple processes.</para>
+    /// </remarks>
+    public sealed class ObjectCache
+        : IDisposable
+    {
+        /// <summary>Creates a cache, or opens an existing one</summary>
+        /// <param name="cacheDirectory">Directory to hold the cached object files, it is created if it doesn't exist</param>
+        /// <param name="maxSizeInBytes">Maximum total size of the object files in the cache, 0 disables eviction</param>
+        public ObjectCache( string cacheDirectory, long maxSizeInBytes )
+        {
+            if( string.IsNullOrWhiteSpace( cacheDirectory ) )
+            {
+                throw new ArgumentException( "Cache directory cannot be null, empty or whitespace", nameof( cacheDirectory ) );
+            }
+
+            if( maxSizeInBytes < 0 )
+            {
+                throw new ArgumentOutOfRangeException( nameof( maxSizeInBytes ) );
+            }
+
+            CacheHandle = NativeMethods.CreateObjectCache( cacheDirectory, ( ulong )maxSizeInBytes, out string errMsg );
+            if( CacheHandle.IsInvalid )
+            {
+                throw new InternalCodeGeneratorException( errMsg );
+            }
+        }
+
+        /// <summary>Gets the object file for a module from the cache, compiling it on a miss</summary>
+        /// <param name="module">Module to compile</param>
+        /// <param name="targetMachine">Target machine to generate code for</param>
+        /// <param name="passPipeline">Textual pass pipeline to optimize the module with, in the syntax of the LLVM 'opt' tool's -passes option, or <see langword="null"/> to not optimize</param>
+        /// <returns>Object file for the module</returns>
+        /// <remarks>
+        /// On a hit the module is not modified, on a miss <paramref name="passPipeline"/> is run on the module before
+        /// generating the code. Thus, whether the module is optimized when this returns depends on the state of the cache.
+        /// </remarks>
+        public MemoryBuffer CompileModule( NativeModule module, TargetMachine targetMachine, string passPipeline )
+        {
+            if( module == null )
+            {
+                throw new ArgumentNullException( nameof( module ) );
+            }
+
+            if( targetMachine == null )
+            {
+                throw new ArgumentNullException( nameof( targetMachine ) );
+            }
+
+            if( NativeMethods.ObjectCacheCompileModule( CacheHandle
+                                                      , module.ModuleHandle
+                                                      , targetMachine.TargetMachineHandle
+                                                      , passPipeline
+                                                      , LLVMOptVerifierKind.None
+                                                      , out LLVMMemoryBufferRef bufferHandle
+                                                      , out string errMsg
+                                                      ).Failed )
+            {
+                throw new InternalCodeGeneratorException( errMsg );
+            }
+
+            return new MemoryBuffer( bufferHandle );
+        }
+
+        /// <summary>Gets the number of modules found in the cache</summary>
+        public long HitCount => ( long )GetStats( ).Hits;
+
+        /// <summary>Gets the number of modules not found in the cache, and thus compiled</summary>
+        public long MissCount => ( long )GetStats( ).Misses;
+
+        /// <summary>Gets the number of object files evicted from the cache</summary>
+        public long EvictionCount => ( long )GetStats( ).Evictions;
+
+        /// <summary>Gets the total size of the object files in the cache</summary>
+        public long SizeInBytes => ( long )GetStats( ).SizeInBytes;
+
+        public void Dispose( )
+        {
+            CacheHandle.Dispose( );
+        }
+
+        private LLVMObjectCacheStats GetStats( )
+        {
+            NativeMethods.ObjectCacheGetStats( CacheHandle, out LLVMObjectCacheStats stats );
+            return stats;
+        }
+
+        private readonly LLVMObjectCacheRef CacheHandle;
+    }
+}
@@ -0,0 +1,122 @@
+﻿using System;
+using System.Collections.Generic;
+using Llvm.NET.Native;
+
+namespace Llvm.NET
+{
+    /// <summary>In process JIT for the host, based on the LLVM ORC JIT stack</summary>
+    /// <remarks>
+    /// The native target must be registered (see <see cref="StaticState.RegisterNative"/>)
+    /// before creating an instance of this class. Modules added to the JIT are owned by it,
+    /// thus the <see cref="Context"/> of any module added must not be disposed before the JIT.
+    /// </remarks>
+    public sealed class OrcJit
+        : IDisposable
+    {
+        /// <summary>Creates a JIT for the host CPU and features</summary>
+        public OrcJit( )
+        {
+            JitStackHandle = NativeMethods.OrcCreateNativeInstance( out string errMsg );
+            if( JitStackHandle.Pointer == IntPtr.Zero )
+            {
+                throw new InternalCodeGeneratorException( errMsg );
+            }
+        }
+
+        /// <summary>Disposes the JIT and the modules in it</summary>
+        /// <remarks>
+        /// There is no finalizer, as the JIT must be disposed before the <see cref="Context"/> of any
+        /// module in it, which finalization order doesn't guarantee. Thus, the JIT must be disposed
+        /// explicitly.
+        /// </remarks>
+        public void Dispose( )
+        {
+            DisposeJit( );
+        }
+
+        /// <summary>Adds a module whose functions are compiled lazily, on their first call</summary>
+        /// <param name="module">Module to add, the JIT takes ownership of the module</param>
+        /// <returns>Handle for the module in the JIT</returns>
+        /// <remarks>
+        /// Each function in the module is called through a stub that triggers compilation
+        /// of the function the first time it is called. Thus, functions that are never called
+        /// are never compiled. Symbols not defined by modules in the JIT are resolved from
+        /// the symbols of the current process.
+        /// </remarks>
+        public int AddLazilyCompiledModule( NativeModule module )
+        {
+            ValidateModule( module );
+            var handle = NativeMethods.OrcAddLazilyCompiledModule( JitStackHandle, module.ModuleHandle );
+            TransferOwnership( module );
+            return handle.Value;
+        }
+
+        /// <summary>Adds a module that is compiled immediately</summary>
+        /// <param name="module">Module to add, the JIT takes ownership of the module</param>
+        /// <returns>Handle for the module in the JIT</returns>
+        public int AddEagerlyCompiledModule( NativeModule module )
+        {
+            ValidateModule( module );
+            var handle = NativeMethods.OrcAddEagerlyCompiledModule( JitStackHandle, module.ModuleHandle );
+            TransferOwnership( module );
+            return handle.Value;
+        }
+
+        /// <summary>Removes a module previously added to the JIT</summary>
+        /// <param name="moduleHandle">Handle of the module returned when it was added</param>
+        public void RemoveModule( int moduleHandle )
+        {
+            NativeMethods.OrcRemoveModule( JitStackHandle, new LLVMOrcModuleHandle( moduleHandle ) );
+        }
+
+        /// <summary>Gets the address of a symbol in the JIT</summary>
+        /// <param name="name">Name of the symbol (unmangled)</param>
+        /// <returns>Address of the symbol or <see cref="IntPtr.Zero"/> if not found</returns>
+        /// <remarks>
+        /// For lazily compiled modules the address is that of the function's stub, so retrieving
+        /// it does not compile the function.
+        /// </remarks>
+        public IntPtr GetSymbolAddress( string name )
+        {
+            if( string.IsNullOrWhiteSpace( name ) )
+            {
+                throw new ArgumentException( "Null or empty symbol names are not valid", nameof( name ) );
+            }
+
+            return new IntPtr( ( long )NativeMethods.OrcGetSymbolAddress( JitStackHandle, name ).Value );
+        }
+
+        private void ValidateModule( NativeModule module )
+        {
+            if( module == null )
+            {
+                throw new ArgumentNullException( nameof( module ) );
+            }
+
+            if( module.IsDisposed )
+            {
+                throw new ArgumentException( "Module is disposed", nameof( module ) );
+            }
+        }
+
+        private void TransferOwnership( NativeModule module )
+        {
+            // Keep the context alive for as long as the JIT holds modules in it
+            OwnedContexts.Add( module.Context );
+            module.Detach( );
+        }
+
+        private void DisposeJit( )
+        {
+            if( JitStackHandle.Pointer != IntPtr.Zero )
+            {
+                NativeMethods.OrcDisposeInstance( JitStackHandle );
+                JitStackHandle = default( LLVMOrcJITStackRef );
+                OwnedContexts.Clear( );
+            }
+        }
+
+        private LLVMOrcJITStackRef JitStackHandle;
+        private readonly HashSet<Context> OwnedContexts = new HashSet<Context>( );
+    }
+}
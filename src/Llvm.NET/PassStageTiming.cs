@@ -0,0 +1,30 @@
+﻿using System;
+using Llvm.NET.Native;
+
+namespace Llvm.NET
+{
+    /// <summary>Timing of one stage of a pass pipeline</summary>
+    /// <seealso cref="NativeModule.OptimizeWithTiming(TargetMachine, string, bool)"/>
+    public struct PassStageTiming
+    {
+        /// <summary>Pipeline text of the stage, or "verify" for the verification at the start and end</summary>
+        public string PassName { get; }
+
+        /// <summary>Elapsed wall clock time of the stage</summary>
+        public TimeSpan WallTime { get; }
+
+        /// <summary>Number of instructions in the module before the stage ran</summary>
+        public long InstructionCountBefore { get; }
+
+        /// <summary>Number of instructions in the module after the stage ran</summary>
+        public long InstructionCountAfter { get; }
+
+        internal PassStageTiming( LLVMPassTimingRecord nativeRecord )
+        {
+            PassName = nativeRecord.PassName;
+            WallTime = TimeSpan.FromTicks( ( long )( nativeRecord.WallTimeInSeconds * TimeSpan.TicksPerSecond ) );
+            InstructionCountBefore = ( long )nativeRecord.InstructionCountBefore;
+            InstructionCountAfter = ( long )nativeRecord.InstructionCountAfter;
+        }
+    }
+}
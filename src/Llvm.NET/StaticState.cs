@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Linq;
 using Llvm.NET.Native;
 
 namespace Llvm.NET
@@ -45,7 +46,42 @@ public static void ParseCommandLineOptions( string[ ] args, string overview )
                 throw new ArgumentNullException( nameof( args ) );
             }
 
-            NativeMethods.ParseCommandLineOptions( args.Length, args, overview );
+            // LLVM terminates the process if an option that only allows one occurrence is set twice
+            bool setsSplitDwarf = args.Skip( 1 ).Any( IsSplitDwarfOption );
+            lock( SplitDwarfLock )
+            {
+                if( setsSplitDwarf && SplitDwarfOptionSet )
+                {
+                    throw new ArgumentException( "The -split-dwarf option is already set", nameof( args ) );
+                }
+
+                NativeMethods.ParseCommandLineOptions( args.Length, args, overview );
+                SplitDwarfOptionSet |= setsSplitDwarf;
+            }
+        }
+
+        /// <summary>Enables split DWARF in code generation</summary>
+        /// <remarks>
+        /// <para>This is a process wide setting for all subsequent code generation. The debug information
+        /// of compilation units with a split debug file name is emitted into .dwo sections of the
+        /// generated object file, leaving only a skeleton compilation unit in the regular sections.
+        /// The .dwo sections are extracted into the split file with a tool such as objcopy.
+        /// Split DWARF is only supported for ELF targets.</para>
+        /// <para>This sets the -split-dwarf command line option, which LLVM only allows once per process.
+        /// Thus, calling this more than once has no effect, and if the option was already passed to
+        /// <see cref="ParseCommandLineOptions(string[], string)"/> this does nothing, even if that disabled
+        /// split DWARF. Once this is called, passing the option to <see cref="ParseCommandLineOptions(string[], string)"/>
+        /// throws an <see cref="ArgumentException"/>.</para>
+        /// </remarks>
+        public static void EnableSplitDwarf( )
+        {
+            lock( SplitDwarfLock )
+            {
+                if( !SplitDwarfOptionSet )
+                {
+                    ParseCommandLineOptions( new[ ] { "Llvm.NET", "-split-dwarf=Enable" }, "Split DWARF" );
+                }
+            }
         }
 
         public static void InitializeOptimization()
@@ -560,5 +596,23 @@ public static void RegisterXCore( TargetRegistrations registrations = TargetRegi
             //    LLVMNative.InitializeXCoreAsmParser( );
             */
         }
+
+        // matches "-split-dwarf", "--split-dwarf" and either with a value ("-split-dwarf=Enable")
+        private static bool IsSplitDwarfOption( string arg )
+        {
+            if( arg == null )
+            {
+                return false;
+            }
+
+            const string optionName = "split-dwarf";
+            string name = arg.TrimStart( '-' );
+            return arg.StartsWith( "-", StringComparison.Ordinal )
+                && name.StartsWith( optionName, StringComparison.Ordinal )
+                && ( name.Length == optionName.Length || name[ optionName.Length ] == '=' );
+        }
+
+        private static readonly object SplitDwarfLock = new object( );
+        private static bool SplitDwarfOptionSet;
     }
 }
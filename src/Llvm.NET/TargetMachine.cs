@@ -1,4 +1,6 @@
 ﻿using System;
+using System.Collections.Generic;
+using System.Linq;
 using Llvm.NET.Native;
 
 namespace Llvm.NET
@@ -108,6 +110,48 @@ public MemoryBuffer EmitToBuffer( NativeModule module, CodeGenFileType fileType
             return new MemoryBuffer( bufferHandle );
         }
 
+        /// <summary>Splits a module by function and generates code for all the partitions in parallel</summary>
+        /// <param name="module"><see cref="NativeModule"/> to generate the code from</param>
+        /// <param name="partitionCount">Number of partitions (and threads) to generate code with</param>
+        /// <param name="fileType">Type of file to emit</param>
+        /// <returns>Buffers containing the generated code for each partition</returns>
+        /// <remarks>
+        /// Each partition is generated in its own context with its own target machine, the
+        /// <paramref name="module"/> itself is not modified.
+        /// </remarks>
+        public IReadOnlyList<MemoryBuffer> EmitPartitionsToBuffers( NativeModule module, int partitionCount, CodeGenFileType fileType )
+        {
+            if( module == null )
+            {
+                throw new ArgumentNullException( nameof( module ) );
+            }
+
+            if( partitionCount < 1 )
+            {
+                throw new ArgumentOutOfRangeException( nameof( partitionCount ) );
+            }
+
+            if( module.TargetTriple != null && Triple != module.TargetTriple )
+            {
+                throw new ArgumentException( "Triple specified for the module doesn't match target machine", nameof( module ) );
+            }
+
+            var bufferHandles = new LLVMMemoryBufferRef[ partitionCount ];
+            var status = NativeMethods.TargetMachineEmitPartitionsToMemoryBuffers( TargetMachineHandle
+                                                                                 , module.ModuleHandle
+                                                                                 , ( uint )partitionCount
+                                                                                 , ( LLVMCodeGenFileType )fileType
+                                                                                 , bufferHandles
+                                                                                 , out string errTxt
+                                                                                 );
+            if( status.Failed )
+            {
+                throw new InternalCodeGeneratorException( errTxt );
+            }
+
+            return bufferHandles.Select( h => new MemoryBuffer( h ) ).ToList( ).AsReadOnly( );
+        }
+
         /// <summary><see cref="Context"/>This machine is associated with</summary>
         public Context Context { get; }
 
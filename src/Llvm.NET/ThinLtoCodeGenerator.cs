@@ -0,0 +1,92 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using Llvm.NET.Native;
+
+namespace Llvm.NET
+{
+    /// <summary>Summary based (ThinLTO) link time optimization and code generation for a set of modules</summary>
+    /// <remarks>
+    /// <para>Each module added is serialized along with a summary of its symbols and references. <see cref="Run"/>
+    /// combines the summaries into a global index, imports functions across modules based on it, then optimizes
+    /// and generates code for each module concurrently on a pool of worker threads. This provides most of the
+    /// benefit of full LTO without a single threaded whole program optimization step, or the memory required to
+    /// hold the entire program in one module.</para>
+    /// <para>Modules are not retained, so they may be modified or disposed once they are added.</para>
+    /// </remarks>
+    public sealed class ThinLtoCodeGenerator
+        : IDisposable
+    {
+        /// <summary>Creates a code generator for a target</summary>
+        /// <param name="targetMachine">Target machine providing the CPU, features and code generation options</param>
+        /// <param name="optLevel">Optimization level (0-3) for each module</param>
+        public ThinLtoCodeGenerator( TargetMachine targetMachine, int optLevel )
+        {
+            if( targetMachine == null )
+            {
+                throw new ArgumentNullException( nameof( targetMachine ) );
+            }
+
+            if( optLevel < 0 || optLevel > 3 )
+            {
+                throw new ArgumentOutOfRangeException( nameof( optLevel ) );
+            }
+
+            CodeGenHandle = NativeMethods.CreateThinLtoCodeGen( targetMachine.TargetMachineHandle, ( uint )optLevel );
+        }
+
+        /// <summary>Adds a module to the set to optimize</summary>
+        /// <param name="module">Module to add</param>
+        /// <remarks>
+        /// The <see cref="NativeModule.Name"/> of each module must be unique and all modules must have the
+        /// same <see cref="NativeModule.TargetTriple"/>.
+        /// </remarks>
+        public void AddModule( NativeModule module )
+        {
+            if( module == null )
+            {
+                throw new ArgumentNullException( nameof( module ) );
+            }
+
+            if( NativeMethods.ThinLtoAddModule( CodeGenHandle, module.ModuleHandle, out string errMsg ).Failed )
+            {
+                throw new ArgumentException( errMsg, nameof( module ) );
+            }
+        }
+
+        /// <summary>Marks a symbol as referenced from outside of the modules so that it is not internalized or removed</summary>
+        /// <param name="name">Name of the symbol</param>
+        public void PreserveSymbol( string name )
+        {
+            if( string.IsNullOrWhiteSpace( name ) )
+            {
+                throw new ArgumentException( "Null or empty symbol names are not valid", nameof( name ) );
+            }
+
+            NativeMethods.ThinLtoPreserveSymbol( CodeGenHandle, name );
+        }
+
+        /// <summary>Runs the import, optimization and code generation for all of the modules</summary>
+        /// <returns>Object files for each module, in the order the modules were added</returns>
+        public IReadOnlyList<MemoryBuffer> Run( )
+        {
+            if( NativeMethods.ThinLtoRun( CodeGenHandle, out string errMsg ).Failed )
+            {
+                throw new InternalCodeGeneratorException( errMsg );
+            }
+
+            uint count = NativeMethods.ThinLtoGetObjectCount( CodeGenHandle );
+            return Enumerable.Range( 0, ( int )count )
+                             .Select( i => new MemoryBuffer( NativeMethods.ThinLtoGetObject( CodeGenHandle, ( uint )i ) ) )
+                             .ToList( )
+                             .AsReadOnly( );
+        }
+
+        public void Dispose( )
+        {
+            CodeGenHandle.Dispose( );
+        }
+
+        private readonly LLVMThinLtoCodeGenRef CodeGenHandle;
+    }
+}
@@ -45,7 +45,8 @@ public Triple( string tripleTxt )
 
         /// <summary>Retrieves the final string form of the triple</summary>
         /// <returns>Normalized Triple string</returns>
-        public override string ToString( ) => NativeMethods.TripleAsString( TripleHandle, true );
+        public override string ToString( )
+            => StringMarshaler.FromBorrowedName( NativeMethods.TripleAsString( TripleHandle, true, out size_t length ), length );
 
         /// <summary>Architecture of the triple</summary>
         public TripleArchType ArchitectureType => ( TripleArchType )NativeMethods.TripleGetArchType( TripleHandle );
@@ -75,37 +76,37 @@ public Triple( string tripleTxt )
         /// such triple components used in a normalized triple.
         /// </overloads>
         public static string GetCanonicalName( TripleArchType archType )
-            => NativeMethods.TripleGetArchTypeName( ( LLVMTripleArchType )archType ) ?? string.Empty;
+            => StringMarshaler.FromBorrowedName( NativeMethods.TripleGetArchTypeName( ( LLVMTripleArchType )archType, out size_t length ), length );
 
         /// <summary>Retrieves the canonical name for an architecture sub type</summary>
         /// <param name="subArchType">Architecture sub type</param>
         /// <returns>String name for the architecture sub type</returns>
         public static string GetCanonicalName( TripleSubArchType subArchType )
-            => NativeMethods.TripleGetSubArchTypeName( ( LLVMTripleSubArchType )subArchType ) ?? string.Empty;
+            => StringMarshaler.FromBorrowedName( NativeMethods.TripleGetSubArchTypeName( ( LLVMTripleSubArchType )subArchType, out size_t length ), length );
 
         /// <summary>Retrieves the canonical name for the vendor component of a triple</summary>
         /// <param name="vendorType">Vendor type</param>
         /// <returns>String name for the vendor</returns>
         public static string GetCanonicalName( TripleVendorType vendorType )
-            => NativeMethods.TripleGetVendorTypeName( ( LLVMTripleVendorType )vendorType ) ?? string.Empty;
+            => StringMarshaler.FromBorrowedName( NativeMethods.TripleGetVendorTypeName( ( LLVMTripleVendorType )vendorType, out size_t length ), length );
 
         /// <summary>Retrieves the canonical name for the OS component of a triple</summary>
         /// <param name="osType">OS type</param>
         /// <returns>String name for the OS</returns>
         public static string GetCanonicalName( TripleOSType osType )
-            => NativeMethods.TripleGetOsTypeName( ( LLVMTripleOSType )osType ) ?? string.Empty;
+            => StringMarshaler.FromBorrowedName( NativeMethods.TripleGetOsTypeName( ( LLVMTripleOSType )osType, out size_t length ), length );
 
         /// <summary>Retrieves the canonical name for the environment component of a triple</summary>
         /// <param name="envType">Environment type</param>
         /// <returns>String name for the environment component</returns>
         public static string GetCanonicalName( TripleEnvironmentType envType )
-            => NativeMethods.TripleGetEnvironmentTypeName( ( LLVMTripleEnvironmentType )envType ) ?? string.Empty;
+            => StringMarshaler.FromBorrowedName( NativeMethods.TripleGetEnvironmentTypeName( ( LLVMTripleEnvironmentType )envType, out size_t length ), length );
 
         /// <summary>Retrieves the canonical name for the object component of a triple</summary>
         /// <param name="objFormatType">Object type</param>
         /// <returns>String name for the object component</returns>
         public static string GetCanonicalName( TripleObjectFormatType objFormatType )
-            => NativeMethods.TripleGetObjectFormatTypeName( ( LLVMTripleObjectFormatType )objFormatType ) ?? string.Empty;
+            => StringMarshaler.FromBorrowedName( NativeMethods.TripleGetObjectFormatTypeName( ( LLVMTripleObjectFormatType )objFormatType, out size_t length ), length );
 
         /// <summary>Equality test for a triple</summary>
         /// <param name="other">triple to compare this triple to</param>
@@ -144,7 +145,7 @@ public override int GetHashCode( )
         /// <returns>Normalized string</returns>
         public static string Normalize( string unNormalizedTriple )
         {
-            return NativeMethods.NormalizeTriple( unNormalizedTriple );
+            return StringMarshaler.FromBorrowedName( NativeMethods.NormalizeTriple( unNormalizedTriple, out size_t length ), length );
         }
 
         /// <summary>Gets the default <see cref="TripleObjectFormatType"/> for a given <see cref="TripleArchType"/> and <see cref="TripleOSType"/></summary>
@@ -140,7 +140,7 @@ public void VerifyValidOn( FunctionAttributeIndex index, Value value)
 
         public override string ToString( )
         {
-            return NativeMethods.AttributeToString( NativeAttribute );
+            return StringMarshaler.FromBorrowed( NativeMethods.AttributeToString( NativeAttribute, out size_t length ), length );
         }
 
         public static bool operator ==( AttributeValue left, AttributeValue right ) => Equals( left, right );
@@ -4,6 +4,7 @@
 using System.Linq;
 using System.Runtime.InteropServices;
 using Llvm.NET.DebugInfo;
+using Llvm.NET.Instructions;
 using Llvm.NET.Native;
 using Llvm.NET.Types;
 
@@ -49,6 +50,26 @@ public IReadOnlyList<BasicBlock> BasicBlocks
             }
         }
 
+        /// <summary>All instructions of the function in block order</summary>
+        /// <remarks>
+        /// This retrieves all of the instructions with a single native call, which is considerably
+        /// faster than walking each of the <see cref="BasicBlocks"/> for large functions.
+        /// </remarks>
+        public IReadOnlyList<Instruction> Instructions
+        {
+            get
+            {
+                uint count = NativeMethods.FunctionGetInstructionInfos( ValueHandle, null, 0 );
+                var infos = new LLVMInstructionInfo[ count ];
+                if( count > 0 )
+                {
+                    NativeMethods.FunctionGetInstructionInfos( ValueHandle, infos, count );
+                }
+
+                return Instruction.FromInstructionInfos( Context, infos );
+            }
+        }
+
         /// <summary>Parameters for the function including any method definition specific attributes (i.e. ByVal)</summary>
         public IReadOnlyList<Argument> Parameters => new FunctionParameterList( this );
 
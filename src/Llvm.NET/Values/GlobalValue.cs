@@ -30,6 +30,20 @@ public bool UnnamedAddress
         /// <summary>Flag to indicate if this is a declaration</summary>
         public bool IsDeclaration => NativeMethods.IsDeclaration( ValueHandle );
 
+        /// <summary>Flag to indicate if the body of this global is not yet loaded from a lazily loaded module</summary>
+        /// <seealso cref="NativeModule.LoadLazilyFrom(MemoryBuffer, Context, bool)"/>
+        public bool IsMaterializable => NativeMethods.GlobalValueIsMaterializable( ValueHandle );
+
+        /// <summary>Loads the body of this global from the bitcode of a lazily loaded module</summary>
+        /// <remarks>This does nothing if the global is already materialized</remarks>
+        public void Materialize( )
+        {
+            if( NativeMethods.GlobalValueMaterialize( ValueHandle, out string errMsg ).Failed )
+            {
+                throw new InternalCodeGeneratorException( errMsg );
+            }
+        }
+
         /// <summary>Module containing this global value</summary>
         public NativeModule ParentModule => NativeType.Context.GetModuleFor( NativeMethods.GetGlobalParent( ValueHandle ) );
 
@@ -43,7 +43,8 @@ public string Name
                 NativeMethods.SetValueName( ValueHandle, value );
 
                 // LLVM auto adds a numeric suffix if a register with the same name already exists
-                Debug.Assert( Name.StartsWith( value, StringComparison.Ordinal ) );
+                // and drops the name entirely if the context discards value names
+                Debug.Assert( Name.StartsWith( value, StringComparison.Ordinal ) || Context.DiscardValueNames );
             }
         }
 
@@ -132,10 +133,37 @@ internal Value( LLVMValueRef valueRef )
         internal static T FromHandle<T>( LLVMValueRef valueRef )
             where T : Value
         {
-            var context = Context.GetContextFor( valueRef );
+            return FromHandle<T>( Context.GetContextFor( valueRef ), valueRef );
+        }
+
+        /// <summary>Gets an Llvm.NET managed wrapper for a LibLLVM value handle with a known context</summary>
+        /// <typeparam name="T">Required type for the handle</typeparam>
+        /// <param name="context">Context that owns the value</param>
+        /// <param name="valueRef">Value handle to wrap</param>
+        /// <returns>LLVM.NET managed instance for the handle</returns>
+        /// <exception cref="InvalidCastException">When the handle is for a different type of handle than specified by <typeparamref name="T"/></exception>
+        internal static T FromHandle<T>( Context context, LLVMValueRef valueRef )
+            where T : Value
+        {
             return ( T )context.GetValueFor( valueRef, StaticFactory );
         }
 
+        /// <summary>Gets an Llvm.NET managed wrapper for a LibLLVM value handle with a known context and value ID</summary>
+        /// <typeparam name="T">Required type for the handle</typeparam>
+        /// <param name="context">Context that owns the value</param>
+        /// <param name="valueRef">Value handle to wrap</param>
+        /// <param name="kind">Native value ID of the handle (e.g. from a bulk enumeration of values)</param>
+        /// <returns>LLVM.NET managed instance for the handle</returns>
+        /// <remarks>
+        /// Values from a bulk enumeration all come from the same context, thus this avoids looking
+        /// up the context of each value in addition to the native call to retrieve the kind.
+        /// </remarks>
+        internal static T FromHandle<T>( Context context, LLVMValueRef valueRef, ValueKind kind )
+            where T : Value
+        {
+            return ( T )context.GetValueFor( valueRef, h => StaticFactory( h, kind ) );
+        }
+
         /// <summary>Central factory for creating instances of <see cref="Value"/> and all derived types</summary>
         /// <param name="h">LibLLVM handle for the value</param>
         /// <returns>New Value or derived type instance that wraps the underlying LibLLVM handle</returns>
@@ -143,11 +171,12 @@ internal static T FromHandle<T>( LLVMValueRef valueRef )
         /// This method will determine the correct type for the handle and construct an instance of that
         /// type wrapping the handle.
         /// </remarks>
+        private static Value StaticFactory( LLVMValueRef h ) => StaticFactory( h, NativeMethods.GetValueIdAsKind( h ) );
+
         [SuppressMessage( "Microsoft.Maintainability", "CA1506:AvoidExcessiveClassCoupling", Justification = "Factory that maps wrappers with underlying types" )]
         [SuppressMessage( "Microsoft.Maintainability", "CA1502:AvoidExcessiveComplexity", Justification = "Factory that maps wrappers with underlying types" )]
-        private static Value StaticFactory( LLVMValueRef h )
+        private static Value StaticFactory( LLVMValueRef h, ValueKind kind )
         {
-            var kind = NativeMethods.GetValueIdAsKind( h );
             switch( kind )
             {
             case ValueKind.Argument:
@@ -0,0 +1,125 @@
+﻿using System;
+using System.Collections;
+using System.Collections.Generic;
+using System.Linq;
+using Llvm.NET.Native;
+
+namespace Llvm.NET.Values
+{
+    /// <summary>Operands or users of a set of values retrieved in bulk</summary>
+    /// <remarks>
+    /// The related values of all the source values are retrieved with a single native call
+    /// and stored in a compressed sparse row (CSR) layout. Entry i of this list contains the
+    /// related values of the i'th source value. This is the most efficient means of pulling the
+    /// def-use graph of a function, or module, across the native interop boundary. All of the
+    /// source values must belong to the same <see cref="Context"/>.
+    /// </remarks>
+    public sealed class ValueAdjacencyList
+        : IReadOnlyList<IReadOnlyList<Value>>
+    {
+        /// <summary>Number of source values in the list</summary>
+        public int Count => Offsets.Length - 1;
+
+        /// <summary>Total number of related values for all the source values</summary>
+        public int EdgeCount => Results.Length;
+
+        /// <summary>Gets the related values for a source value</summary>
+        /// <param name="index">Index of the source value</param>
+        /// <returns>Related values of the source value</returns>
+        public IReadOnlyList<Value> this[ int index ]
+        {
+            get
+            {
+                if( index < 0 || index >= Count )
+                {
+                    throw new ArgumentOutOfRangeException( nameof( index ) );
+                }
+
+                int start = ( int )Offsets[ index ];
+                int count = ( int )Offsets[ index + 1 ] - start;
+                var retVal = new Value[ count ];
+                for( int i = 0; i < count; ++i )
+                {
+                    retVal[ i ] = Value.FromHandle<Value>( Context, Results[ start + i ] );
+                }
+
+                return retVal;
+            }
+        }
+
+        public IEnumerator<IReadOnlyList<Value>> GetEnumerator( )
+        {
+            for( int i = 0; i < Count; ++i )
+            {
+                yield return this[ i ];
+            }
+        }
+
+        IEnumerator IEnumerable.GetEnumerator( ) => GetEnumerator( );
+
+        /// <summary>Gets the operands of a set of values</summary>
+        /// <param name="values">Values to get the operands of</param>
+        /// <returns>Operands of each value, in the same order as <paramref name="values"/></returns>
+        /// <exception cref="ArgumentException">When the values don't all belong to the same <see cref="Context"/></exception>
+        /// <remarks>Values that are not a <see cref="User"/> have no operands</remarks>
+        public static ValueAdjacencyList GetOperands( IEnumerable<Value> values )
+        {
+            return Create( values, NativeMethods.GetOperandsBulk );
+        }
+
+        /// <summary>Gets the users of a set of values</summary>
+        /// <param name="values">Values to get the users of</param>
+        /// <returns>Users of each value, in the same order as <paramref name="values"/></returns>
+        /// <exception cref="ArgumentException">When the values don't all belong to the same <see cref="Context"/></exception>
+        public static ValueAdjacencyList GetUsers( IEnumerable<Value> values )
+        {
+            return Create( values, NativeMethods.GetUsersBulk );
+        }
+
+        private ValueAdjacencyList( Context context, uint[ ] offsets, LLVMValueRef[ ] results )
+        {
+            Context = context;
+            Offsets = offsets;
+            Results = results;
+        }
+
+        private static ValueAdjacencyList Create( IEnumerable<Value> values, Func<LLVMValueRef[ ], uint, uint[ ], LLVMValueRef[ ], uint, uint> bulkGet )
+        {
+            if( values == null )
+            {
+                throw new ArgumentNullException( nameof( values ) );
+            }
+
+            var valueList = values.ToList( );
+            var context = valueList.Count == 0 ? null : valueList[ 0 ].Context;
+            if( valueList.Any( v => v.Context != context ) )
+            {
+                throw new ArgumentException( "Values must all belong to the same context", nameof( values ) );
+            }
+
+            // most values only have a few operands or users, so the first call is likely to get all
+            // of them and only the rest need a second call with the exact size
+            var handles = valueList.Select( v => v.ValueHandle ).ToArray( );
+            var offsets = new uint[ handles.Length + 1 ];
+            var results = new LLVMValueRef[ handles.Length * InitialEdgesPerValue ];
+            uint count = bulkGet( handles, ( uint )handles.Length, offsets, results, ( uint )results.Length );
+            if( count > results.Length )
+            {
+                results = new LLVMValueRef[ count ];
+                bulkGet( handles, ( uint )handles.Length, offsets, results, count );
+            }
+            else if( count < results.Length )
+            {
+                Array.Resize( ref results, ( int )count );
+            }
+
+            return new ValueAdjacencyList( context, offsets, results );
+        }
+
+        private const int InitialEdgesPerValue = 4;
+
+        private readonly Context Context;
+        private readonly uint[ ] Offsets;
+        private readonly LLVMValueRef[ ] Results;
+    }
+}
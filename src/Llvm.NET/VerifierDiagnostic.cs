@@ -0,0 +1,33 @@
+﻿using Llvm.NET.Instructions;
+using Llvm.NET.Values;
+
+namespace Llvm.NET
+{
+    /// <summary>Problem found in a function by <see cref="NativeModule.VerifyFunctions(int, int)"/></summary>
+    public class VerifierDiagnostic
+    {
+        /// <summary>Gets the function the problem was found in</summary>
+        public Function Function { get; }
+
+        /// <summary>Gets the instruction the problem was found in, or <see langword="null"/> if it doesn't involve an instruction</summary>
+        public Instruction Instruction { get; }
+
+        /// <summary>Gets an identifier for the check that failed</summary>
+        /// <remarks>
+        /// Diagnostics from the same verification have the same id when the same check failed, which allows
+        /// grouping the problems of large amounts of generated IR without comparing the messages.
+        /// </remarks>
+        public int MessageId { get; }
+
+        /// <summary>Gets the message from the verifier</summary>
+        public string Message { get; }
+
+        internal VerifierDiagnostic( Function function, Instruction instruction, int messageId, string message )
+        {
+            Function = function;
+            Instruction = instruction;
+            MessageId = messageId;
+            Message = message;
+        }
+    }
+}
@@ -1,5 +1,6 @@
 ﻿using System;
 using System.Collections.Generic;
+using System.Linq;
 using Llvm.NET.DebugInfo;
 using Llvm.NET.Types;
 using Llvm.NET.Values;
@@ -25,6 +26,44 @@ public void SimpleConstructorDisposeTest( )
             Assert.IsTrue( context.IsDisposed );
         }
 
+        [TestMethod]
+        public void DiscardValueNamesTest( )
+        {
+            using( var context = new Context( new ContextOptions { DiscardValueNames = true } ) )
+            using( var module = new NativeModule( "test", context ) )
+            {
+                Assert.IsTrue( context.DiscardValueNames );
+
+                var func = module.AddFunction( "func", context.GetFunctionType( context.VoidType ) );
+                func.AppendBasicBlock( "entry" );
+                var local = new Instructions.InstructionBuilder( func.EntryBlock ).Alloca( context.Int32Type );
+                local.Name = "local";
+
+                // globals keep their names, everything else is discarded
+                Assert.AreEqual( "func", func.Name );
+                Assert.AreEqual( string.Empty, local.Name );
+            }
+        }
+
+        [TestMethod]
+        public void UniqueDebugTypesLinkTest( )
+        {
+            using( var context = new Context( new ContextOptions { UniqueDebugTypes = true } ) )
+            using( var sourceContext = new Context( ) )
+            using( var module1 = CreateModuleWithIdentifiedEnum( sourceContext, "module1" ) )
+            using( var module2 = CreateModuleWithIdentifiedEnum( sourceContext, "module2" ) )
+            {
+                Assert.IsTrue( context.UniqueDebugTypes );
+                Assert.IsFalse( sourceContext.UniqueDebugTypes );
+
+                using( var linked = NativeModule.LinkParallel( context, new[ ] { module1, module2 }, 1, out IReadOnlyList<LinkStageTiming> stageTimings ) )
+                {
+                    Assert.IsTrue( linked.Verify( out string errMsg ), errMsg );
+                    Assert.AreEqual( 1, stageTimings.Where( t => t.Kind == LinkStageKind.Merge ).Sum( t => t.DeduplicatedDebugTypeCount ) );
+                }
+            }
+        }
+
         [TestMethod]
         public void GetPointerTypeForTest( )
         {
@@ -975,6 +1014,18 @@ public void CreateMetadataStringWithNullArgTest( )
             }
         }
 
+        [TestMethod]
+        public void CreateMetadataStringKeepsLineEndingsTest( )
+        {
+            using( var context = new Context() )
+            {
+                // the content of a string is data, so the line endings aren't normalized
+                string content = "first\nsecond\r\nthird";
+                var mdstring = context.CreateMetadataString( content );
+                Assert.AreEqual( content, mdstring.ToString( ) );
+            }
+        }
+
         [TestMethod]
         public void CreateConstantStringTest( )
         {
@@ -1016,5 +1067,24 @@ private static void VerifyIntegerType( ITypeRef integerType, uint bitWidth )
             Assert.IsFalse( integerType.IsVoid );
             Assert.AreEqual( bitWidth, integerType.IntegerBitWidth );
         }
+
+        private static NativeModule CreateModuleWithIdentifiedEnum( Context context, string name )
+        {
+            var module = new NativeModule( name, context );
+            module.AddModuleFlag( ModuleFlagBehavior.Warning, NativeModule.DebugVersionValue, NativeModule.DebugMetadataVersion );
+            var compileUnit = module.DIBuilder.CreateCompileUnit( SourceLanguage.CPlusPlus, name + ".cpp", "unit-test", false, string.Empty, 0 );
+            module.DIBuilder.CreateEnumerationType( compileUnit
+                                                  , "Color"
+                                                  , compileUnit.File
+                                                  , 1
+                                                  , 32
+                                                  , 32
+                                                  , new[ ] { module.DIBuilder.CreateEnumeratorValue( "Red", 0 ) }
+                                                  , module.DIBuilder.CreateBasicType( "int", 32, DiTypeKind.Signed )
+                                                  , "_ZTS5Color"
+                                                  );
+            module.DIBuilder.Finish( );
+            return module;
+        }
     }
 }
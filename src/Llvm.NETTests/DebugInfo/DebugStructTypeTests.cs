@@ -0,0 +1,136 @@
+﻿using System.Linq;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+namespace Llvm.NET.DebugInfo.Tests
+{
+    [TestClass]
+    public class DebugStructTypeTests
+    {
+        [TestMethod]
+        public void DebugStructTypeWithMembersTest( )
+        {
+            const string testTriple = "thumbv7m-none--eabi";
+            var target = Target.FromTriple( testTriple );
+            using( var ctx = new Context( ) )
+            using( var targetMachine = target.CreateTargetMachine( ctx, testTriple ) )
+            using( var module = new NativeModule( "testModule", ctx ) { Layout = targetMachine.TargetData } )
+            {
+                const string nativeStructName = "struct.testStruct";
+                const string structSymbolName = "testStruct";
+
+                var diFile = module.DIBuilder.CreateFile( "test.c" );
+                var diCompileUnit = module.DIBuilder.CreateCompileUnit( SourceLanguage.C, "test.c", "unit-test", false, string.Empty, 0 );
+
+                var i32 = new DebugBasicType( module.Context.Int32Type, module, "int", DiTypeKind.Signed );
+                var i16 = new DebugBasicType( module.Context.Int16Type, module, "short", DiTypeKind.Signed );
+                var f32 = new DebugBasicType( module.Context.FloatType, module, "float", DiTypeKind.Float );
+
+                var members = new[ ]
+                    { new DebugMemberInfo { File = diFile, Line = 3, Name = "a", DebugType = i32, Index = 0 }
+                    , new DebugMemberInfo { File = diFile, Line = 4, Name = "bé", DebugType = i16, Index = 1 }
+                    , new DebugMemberInfo { File = diFile, Line = 5, Name = "c", DebugType = f32, Index = 2 }
+                    };
+
+                var structType = new DebugStructType( module, nativeStructName, diCompileUnit, structSymbolName, diFile, 1, DebugInfoFlags.None, members );
+                Assert.AreEqual( Tag.StructureType, structType.DIType.Tag );
+                Assert.AreEqual( structSymbolName, structType.DIType.Name );
+                Assert.AreEqual( 96UL, structType.DIType.BitSize );
+
+                Assert.IsNotNull( structType.DIType.Elements );
+                Assert.AreEqual( members.Length, structType.DIType.Elements.Count );
+                ulong[ ] expectedOffsets = { 0, 32, 64 };
+                for( int i = 0; i < members.Length; ++i )
+                {
+                    var memberType = structType.DIType.Elements[ i ] as DIDerivedType;
+                    Assert.IsNotNull( memberType );
+                    Assert.AreEqual( Tag.Member, memberType.Tag );
+                    Assert.AreEqual( members[ i ].Name, memberType.Name );
+                    Assert.AreEqual( members[ i ].Line, memberType.Line );
+                    Assert.AreEqual( expectedOffsets[ i ], memberType.BitOffset );
+                    Assert.AreEqual( members[ i ].DebugType.DIType, memberType.BaseType );
+                    Assert.AreEqual( structType.DIType, memberType.Scope );
+                }
+
+                module.DIBuilder.Finish( );
+                Assert.IsTrue( module.Verify( out string errMsg ), errMsg );
+            }
+        }
+
+        [TestMethod]
+        public void SameNamedStructsWithDifferentMembersTest( )
+        {
+            using( var module = new NativeModule( ) )
+            {
+                var diFile = module.DIBuilder.CreateFile( "test.c" );
+                var diCompileUnit = module.DIBuilder.CreateCompileUnit( SourceLanguage.C, "test.c", "unit-test", false, string.Empty, 0 );
+                var i32 = new DebugBasicType( module.Context.Int32Type, module, "int", DiTypeKind.Signed );
+                var f32 = new DebugBasicType( module.Context.FloatType, module, "float", DiTypeKind.Float );
+
+                // same name, scope, file, line and size, but different members
+                var intMembers = new[ ] { new DebugMemberInfo { File = diFile, Line = 2, Name = "a", DebugType = i32, Index = 0 } };
+                var floatMembers = new[ ] { new DebugMemberInfo { File = diFile, Line = 2, Name = "b", DebugType = f32, Index = 0 } };
+                var intStruct = new DebugStructType( module, "struct.s.0", diCompileUnit, "s", diFile, 1, DebugInfoFlags.None, intMembers );
+                var floatStruct = new DebugStructType( module, "struct.s.1", diCompileUnit, "s", diFile, 1, DebugInfoFlags.None, floatMembers );
+
+                Assert.AreNotEqual( intStruct.DIType, floatStruct.DIType );
+                Assert.AreEqual( 1, intStruct.DIType.Elements.Count );
+                Assert.AreEqual( "a", ( ( DIDerivedType )intStruct.DIType.Elements[ 0 ] ).Name );
+                Assert.AreEqual( i32.DIType, ( ( DIDerivedType )intStruct.DIType.Elements[ 0 ] ).BaseType );
+                Assert.AreEqual( 1, floatStruct.DIType.Elements.Count );
+                Assert.AreEqual( "b", ( ( DIDerivedType )floatStruct.DIType.Elements[ 0 ] ).Name );
+                Assert.AreEqual( f32.DIType, ( ( DIDerivedType )floatStruct.DIType.Elements[ 0 ] ).BaseType );
+
+                module.DIBuilder.Finish( );
+                Assert.IsTrue( module.Verify( out string errMsg ), errMsg );
+            }
+        }
+
+        [TestMethod]
+        public void DITypeInfoTest( )
+        {
+            using( var module = new NativeModule( ) )
+            {
+                var diFile = module.DIBuilder.CreateFile( "test.c" );
+                var diCompileUnit = module.DIBuilder.CreateCompileUnit( SourceLanguage.C, "test.c", "unit-test", false, string.Empty, 0 );
+                var i32 = new DebugBasicType( module.Context.Int32Type, module, "int", DiTypeKind.Signed );
+                var members = new[ ]
+                    { new DebugMemberInfo { File = diFile, Line = 3, Name = "a", DebugType = i32, Index = 0, ExplicitLayout = new DebugMemberLayout( 32, 32, 0 ) }
+                    , new DebugMemberInfo { File = diFile, Line = 4, Name = "b", DebugType = i32, Index = 1, ExplicitLayout = new DebugMemberLayout( 32, 32, 32 ) }
+                    };
+
+                var structType = new DebugStructType( module, "struct.s", diCompileUnit, "s", diFile, 2, DebugInfoFlags.None, members, bitSize: 64, bitAlignment: 32 );
+
+                var info = structType.DIType.GetInfo( );
+                Assert.AreSame( structType.DIType, info.Type );
+                Assert.AreEqual( Tag.StructureType, info.Tag );
+                Assert.AreEqual( "s", info.Name );
+                Assert.AreEqual( diCompileUnit, info.Scope );
+                Assert.AreEqual( diFile, info.File );
+                Assert.AreEqual( 2U, info.Line );
+                Assert.AreEqual( 64UL, info.BitSize );
+                Assert.AreEqual( 32UL, info.BitAlignment );
+                Assert.AreEqual( 2, info.Elements.Count );
+                Assert.AreEqual( DiTypeKind.Invalid, info.Encoding );
+
+                var memberInfos = DITypeInfo.FromTypes( info.Elements.Cast<DIType>( ) );
+                Assert.AreEqual( 2, memberInfos.Count );
+                for( int i = 0; i < members.Length; ++i )
+                {
+                    Assert.AreEqual( Tag.Member, memberInfos[ i ].Tag );
+                    Assert.AreEqual( members[ i ].Name, memberInfos[ i ].Name );
+                    Assert.AreEqual( members[ i ].Line, memberInfos[ i ].Line );
+                    Assert.AreEqual( members[ i ].ExplicitLayout.BitOffset, memberInfos[ i ].BitOffset );
+                    Assert.AreEqual( i32.DIType, memberInfos[ i ].BaseType );
+                    Assert.AreEqual( structType.DIType, memberInfos[ i ].Scope );
+                    Assert.IsNull( memberInfos[ i ].Elements );
+                }
+
+                var basicInfo = i32.DIType.GetInfo( );
+                Assert.AreEqual( Tag.BaseType, basicInfo.Tag );
+                Assert.AreEqual( "int", basicInfo.Name );
+                Assert.AreEqual( DiTypeKind.Signed, basicInfo.Encoding );
+                Assert.IsNull( basicInfo.BaseType );
+            }
+        }
+    }
+}
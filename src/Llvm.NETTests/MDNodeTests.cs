@@ -1,4 +1,5 @@
-﻿using Llvm.NET.DebugInfo;
+﻿using System.Collections.Generic;
+using Llvm.NET.DebugInfo;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 
 namespace Llvm.NET.Tests
@@ -18,6 +19,40 @@ public void ReplaceAllUsesWithTest( )
             Assert.Inconclusive( );
         }
 
+        [TestMethod]
+        public void ReplaceTemporariesTest( )
+        {
+            using( var module = new NativeModule( "test.bc", SourceLanguage.C, "test.c", "unittests" ) )
+            {
+                var diBuilder = module.DIBuilder;
+                var file = diBuilder.CreateFile( "test.c" );
+
+                // struct A { struct B* b; }; struct B { struct A* a; };
+                var tempA = diBuilder.CreateReplaceableCompositeType( Tag.StructureType, "A", module.DICompileUnit, file, 1 );
+                var tempB = diBuilder.CreateReplaceableCompositeType( Tag.StructureType, "B", module.DICompileUnit, file, 2 );
+                var memberA = diBuilder.CreateMemberType( tempA, "b", file, 1, 64, 0, 0, DebugInfoFlags.None, diBuilder.CreatePointerType( tempB, string.Empty, 64 ) );
+                var memberB = diBuilder.CreateMemberType( tempB, "a", file, 2, 64, 0, 0, DebugInfoFlags.None, diBuilder.CreatePointerType( tempA, string.Empty, 64 ) );
+                var structA = diBuilder.CreateStructType( module.DICompileUnit, "A", file, 1, 64, 0, DebugInfoFlags.None, null, memberA );
+                var structB = diBuilder.CreateStructType( module.DICompileUnit, "B", file, 2, 64, 0, DebugInfoFlags.None, null, memberB );
+                Assert.IsFalse( structA.IsResolved );
+                Assert.IsFalse( structB.IsResolved );
+
+                MDNode.ReplaceTemporaries( new[ ]
+                    { new KeyValuePair<MDNode, LlvmMetadata>( tempA, structA )
+                    , new KeyValuePair<MDNode, LlvmMetadata>( tempB, structB )
+                    } );
+
+                Assert.IsTrue( tempA.IsDeleted );
+                Assert.IsTrue( tempB.IsDeleted );
+                Assert.IsTrue( structA.IsResolved );
+                Assert.IsTrue( structB.IsResolved );
+
+                var resolvedMemberA = ( DIDerivedType )structA.Elements[ 0 ];
+                Assert.AreEqual( structA, resolvedMemberA.Scope );
+                Assert.AreEqual( structB, ( ( DIDerivedType )resolvedMemberA.BaseType ).BaseType );
+            }
+        }
+
         [TestMethod]
         public void OperandsAreAccessibleTest()
         {
@@ -0,0 +1,99 @@
+﻿using System;
+using System.IO;
+using System.Runtime.InteropServices;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+namespace Llvm.NET.Tests
+{
+    [TestClass]
+    public class MemoryBufferTests
+    {
+        [TestMethod]
+        public void MapFileTest( )
+        {
+            string path = Path.GetTempFileName( );
+            try
+            {
+                using( var context = new Context( ) )
+                {
+                    // LLVM only maps files of at least 4 pages, the constant data makes the bit-code well above that
+                    WriteTestModule( context, path, 256 * 1024 );
+                    long fileSize = new FileInfo( path ).Length;
+                    Assert.IsTrue( fileSize > 64 * 1024 );
+
+                    using( var buffer = MemoryBuffer.MapFile( path ) )
+                    {
+                        Assert.IsTrue( buffer.IsMemoryMapped );
+                        Assert.AreEqual( fileSize, ( long )buffer.Size );
+                        Assert.AreNotEqual( IntPtr.Zero, buffer.Start );
+
+                        // bit-code files start with the magic number 'BC' 0xC0DE
+                        Assert.AreEqual( ( byte )'B', Marshal.ReadByte( buffer.Start ) );
+                        Assert.AreEqual( ( byte )'C', Marshal.ReadByte( buffer.Start, 1 ) );
+
+                        using( var module = NativeModule.LoadFrom( buffer, context ) )
+                        {
+                            Assert.IsNotNull( module.GetFunction( "function" ) );
+                            Assert.IsNotNull( module.GetNamedGlobal( "data" ) );
+                        }
+                    }
+                }
+            }
+            finally
+            {
+                File.Delete( path );
+            }
+        }
+
+        [TestMethod]
+        public void MapSmallFileTest( )
+        {
+            string path = Path.GetTempFileName( );
+            try
+            {
+                using( var context = new Context( ) )
+                {
+                    // small files are read into memory instead of mapped
+                    WriteTestModule( context, path, 16 );
+                    using( var buffer = MemoryBuffer.MapFile( path ) )
+                    {
+                        Assert.IsFalse( buffer.IsMemoryMapped );
+                        Assert.AreEqual( new FileInfo( path ).Length, ( long )buffer.Size );
+
+                        using( var module = NativeModule.LoadFrom( buffer, context ) )
+                        {
+                            Assert.IsNotNull( module.GetFunction( "function" ) );
+                        }
+                    }
+                }
+            }
+            finally
+            {
+                File.Delete( path );
+            }
+        }
+
+        [TestMethod]
+        public void DisposedBufferTest( )
+        {
+            var buffer = MemoryBuffer.MapFile( typeof( MemoryBufferTests ).Assembly.Location );
+            buffer.Dispose( );
+            Assert.IsFalse( buffer.IsMemoryMapped );
+            Assert.AreEqual( IntPtr.Zero, buffer.Start );
+            Assert.AreEqual( 0, buffer.Size );
+        }
+
+        private static void WriteTestModule( Context context, string path, int dataSize )
+        {
+            using( var module = new NativeModule( "test", context ) )
+            {
+                var data = context.CreateConstantString( new string( 'x', dataSize ) );
+                module.AddGlobal( data.NativeType, true, Linkage.Internal, data, "data" );
+
+                var function = module.AddFunction( "function", context.GetFunctionType( context.VoidType ) );
+                new Instructions.InstructionBuilder( function.AppendBasicBlock( "entry" ) ).Return( );
+                module.WriteToFile( path );
+            }
+        }
+    }
+}
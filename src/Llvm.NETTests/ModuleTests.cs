@@ -1,8 +1,13 @@
 ﻿using System;
+using System.Collections.Generic;
 using System.IO;
 using System.Linq;
+using System.Text;
+using System.Text.RegularExpressions;
+using Llvm.NET.DebugInfo;
 using Llvm.NET.Instructions;
 using Llvm.NET.Values;
+using Llvm.NET.Values.Tests;
 using Llvm.NETTests;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 
@@ -161,6 +166,46 @@ public void MultiContextCloneLinkTest( )
             }
         }
 
+        [TestMethod]
+        public void LinkParallelTest( )
+        {
+            using( var context = new Context( ) )
+            using( var sourceContext = new Context( ) )
+            {
+                var modules = Enumerable.Range( 0, 5 ).Select( i => CreateSimpleModule( $"module{i}", sourceContext ) ).ToList( );
+                try
+                {
+                    using( var linked = NativeModule.LinkParallel( context, modules, 3, out IReadOnlyList<LinkStageTiming> stageTimings ) )
+                    {
+                        Assert.IsTrue( linked.Verify( out string errMsg ), errMsg );
+                        foreach( var module in modules )
+                        {
+                            Assert.IsNotNull( linked.GetFunction( module.Name ) );
+                        }
+
+                        // 5 modules are merged in 3 levels: 2 pairs, 1 pair and the last pair
+                        var expectedKinds = new[ ]
+                        {
+                            LinkStageKind.Serialize,
+                            LinkStageKind.Load,
+                            LinkStageKind.Merge,
+                            LinkStageKind.Merge,
+                            LinkStageKind.Merge,
+                            LinkStageKind.Finalize
+                        };
+
+                        CollectionAssert.AreEqual( expectedKinds, stageTimings.Select( t => t.Kind ).ToArray( ) );
+                        CollectionAssert.AreEqual( new[ ] { 0, 0, 0, 1, 2, 0 }, stageTimings.Select( t => t.Level ).ToArray( ) );
+                        CollectionAssert.AreEqual( new[ ] { 5, 5, 2, 1, 1, 1 }, stageTimings.Select( t => t.TaskCount ).ToArray( ) );
+                    }
+                }
+                finally
+                {
+                    modules.ForEach( m => m.Dispose( ) );
+                }
+            }
+        }
+
         [TestMethod]
         public void VerifyValidModuleTest( )
         {
@@ -195,6 +240,77 @@ public void VerifyInvalidModuleTest( )
             }
         }
 
+        [TestMethod]
+        public void VerifyFunctionsTest( )
+        {
+            using( var module = new NativeModule( TestModuleName ) )
+            {
+                CreateSimpleVoidNopTestFunction( module, "goodfunc" );
+                Function badFunc1 = CreateInvalidFunction( module, "badfunc1" );
+                Function badFunc2 = CreateInvalidFunction( module, "badfunc2" );
+
+                var diagnostics = module.VerifyFunctions( 2 );
+                Assert.AreEqual( 2, diagnostics.Count );
+                Assert.AreEqual( badFunc1, diagnostics[ 0 ].Function );
+                Assert.AreEqual( badFunc2, diagnostics[ 1 ].Function );
+
+                // both functions fail the same check
+                Assert.AreEqual( diagnostics[ 0 ].MessageId, diagnostics[ 1 ].MessageId );
+                Assert.IsFalse( string.IsNullOrWhiteSpace( diagnostics[ 0 ].Message ) );
+            }
+        }
+
+        [TestMethod]
+        public void VerifyFunctionsMaxErrorsTest( )
+        {
+            using( var module = new NativeModule( TestModuleName ) )
+            {
+                Function badFunc1 = CreateInvalidFunction( module, "badfunc1" );
+                CreateInvalidFunction( module, "badfunc2" );
+                CreateInvalidFunction( module, "badfunc3" );
+
+                // the first error in function order is reported regardless of thread scheduling
+                var diagnostics = module.VerifyFunctions( 3, 1 );
+                Assert.AreEqual( 1, diagnostics.Count );
+                Assert.AreEqual( badFunc1, diagnostics[ 0 ].Function );
+            }
+        }
+
+        [TestMethod]
+        public void VerifyFunctionsReportsEachCheckTest( )
+        {
+            using( var context = new Context( ) )
+            using( var module = new NativeModule( TestModuleName, context ) )
+            {
+                var bytePtr = context.Int8Type.CreatePointerType( );
+                var copy = module.AddFunction( "copy", context.GetFunctionType( context.VoidType, bytePtr, bytePtr ) );
+                var builder = new InstructionBuilder( copy.AppendBasicBlock( "entry" ) );
+
+                // an alignment that isn't a power of 2 fails a check with a lower case description
+                var firstCopy = builder.MemCpy( module, copy.Parameters[ 0 ], copy.Parameters[ 1 ], context.CreateConstant( 4 ), 3, false );
+                var secondCopy = builder.MemCpy( module, copy.Parameters[ 0 ], copy.Parameters[ 1 ], context.CreateConstant( 8 ), 3, false );
+                builder.Return( );
+
+                var diagnostics = module.VerifyFunctions( 2 );
+                Assert.AreEqual( 2, diagnostics.Count );
+                Assert.AreSame( copy, diagnostics[ 0 ].Function );
+                Assert.AreSame( firstCopy, diagnostics[ 0 ].Instruction );
+                Assert.AreSame( copy, diagnostics[ 1 ].Function );
+                Assert.AreSame( secondCopy, diagnostics[ 1 ].Instruction );
+                Assert.AreEqual( diagnostics[ 0 ].MessageId, diagnostics[ 1 ].MessageId );
+                foreach( var diagnostic in diagnostics )
+                {
+                    Assert.IsTrue( diagnostic.Message.StartsWith( "alignment argument of memory intrinsics must be a power of 2\n", StringComparison.Ordinal ), diagnostic.Message );
+                }
+
+                var limited = module.VerifyFunctions( 2, 1 );
+                Assert.AreEqual( 1, limited.Count );
+                Assert.AreSame( firstCopy, limited[ 0 ].Instruction );
+                Assert.AreEqual( diagnostics[ 0 ].Message, limited[ 0 ].Message );
+            }
+        }
+
+        // module with debug information, a comdat function, a constant global and an unnamed global
         [TestMethod]
         public void AddFunctionGetFunctionTest( )
         {
@@ -213,6 +329,27 @@ public void AddFunctionGetFunctionTest( )
             }
         }
 
+        [TestMethod]
+        public void InstructionsTest( )
+        {
+            using( var context = new Context( ) )
+            using( var module = new NativeModule( TestModuleName, context ) )
+            {
+                var first = FunctionTests.CreateTestFunction( module, "first" );
+                module.AddFunction( "external", context.GetFunctionType( context.VoidType ) );
+                var second = FunctionTests.CreateTestFunction( module, "second" );
+
+                // instructions are in function order, declarations don't have any
+                var expected = first.Instructions.Concat( second.Instructions ).ToList( );
+                var instructions = module.Instructions;
+                Assert.AreEqual( expected.Count, instructions.Count );
+                for( int i = 0; i < expected.Count; ++i )
+                {
+                    Assert.AreSame( expected[ i ], instructions[ i ] );
+                }
+            }
+        }
+
         [TestMethod]
         public void WriteToFileTest( )
         {
@@ -245,6 +382,21 @@ public void WriteToFileTest( )
             }
         }
 
+        [TestMethod]
+        public void WriteToStreamTest( )
+        {
+            using( var module = new NativeModule( TestModuleName ) )
+            using( var stream = new MemoryStream( ) )
+            {
+                CreateSimpleVoidNopTestFunction( module, "foo" );
+                module.WriteToStream( stream );
+                using( var buffer = module.WriteToBuffer( ) )
+                {
+                    CollectionAssert.AreEqual( buffer.ToArray( ), stream.ToArray( ) );
+                }
+            }
+        }
+
         [TestMethod]
         public void AsStringTest( )
         {
@@ -387,6 +539,37 @@ public void LoadFromTest( )
             Assert.Inconclusive( );
         }
 
+        [TestMethod]
+        public void LoadLazilyFromTest( )
+        {
+            using( var module = new NativeModule( TestModuleName ) )
+            {
+                CreateSimpleVoidNopTestFunction( module, "foo" );
+                CreateSimpleVoidNopTestFunction( module, "bar" );
+
+                using( var ctx = new Context( ) )
+                using( var buffer = module.WriteToBuffer( ) )
+                using( var lazyModule = NativeModule.LoadLazilyFrom( buffer, ctx ) )
+                {
+                    Assert.AreEqual( 0, buffer.Size, "Buffer should be owned by the module" );
+
+                    Function foo = lazyModule.GetFunction( "foo" );
+                    Function bar = lazyModule.GetFunction( "bar" );
+                    Assert.IsTrue( foo.IsMaterializable );
+                    Assert.IsTrue( bar.IsMaterializable );
+
+                    foo.Materialize( );
+                    Assert.IsFalse( foo.IsMaterializable );
+                    Assert.AreEqual( 1, foo.BasicBlocks.Count );
+                    Assert.IsTrue( bar.IsMaterializable );
+
+                    lazyModule.MaterializeAll( );
+                    Assert.IsFalse( bar.IsMaterializable );
+                    Assert.AreEqual( 1, bar.BasicBlocks.Count );
+                }
+            }
+        }
+
         [TestMethod]
         public void ComdatDataTest( )
         {
@@ -457,6 +640,125 @@ public void ComdatFunctionTest( )
             }
         }
 
+        [TestMethod]
+        public void ComdatNameRoundTripTest( )
+        {
+            // names are UTF-8 in LLVM, so non-ASCII names must survive the trip in both directions
+            const string comdatName = "comdat_\u00e4\u20ac\u540d";
+            using( var context = new Context( ) )
+            using( var module = new NativeModule( TestModuleName, context ) )
+            {
+                var function = CreateSimpleVoidNopTestFunction( module, "function" );
+                function.Linkage = Linkage.LinkOnceODR;
+                var comdat = module.Comdats.Add( comdatName, ComdatKind.Any );
+                function.Comdat = comdat;
+                Assert.AreEqual( comdatName, comdat.Name );
+                Assert.AreEqual( comdatName, function.Comdat.Name );
+                Assert.IsTrue( module.Comdats.Contains( comdatName ) );
+
+                // the comdats of a new module are read from the native module
+                using( var clone = module.Clone( ) )
+                {
+                    Assert.AreEqual( 1, clone.Comdats.Count );
+                    Assert.IsTrue( clone.Comdats.Contains( comdatName ) );
+                    Assert.AreEqual( comdatName, clone.GetFunction( "function" ).Comdat.Name );
+                }
+            }
+        }
+
+        [TestMethod]
+        public void CompileUnitEmissionKindTest( )
+        {
+            using( var module = new NativeModule( TestModuleName ) )
+            {
+                var compileUnit = module.DIBuilder.CreateCompileUnit( DebugInfo.SourceLanguage.C
+                                                                    , "test.c"
+                                                                    , "unit-test"
+                                                                    , "Llvm.NETTests"
+                                                                    , true
+                                                                    , string.Empty
+                                                                    , 0
+                                                                    , DebugInfo.DwarfEmissionKind.LineTablesOnly
+                                                                    , "test.dwo"
+                                                                    );
+                Assert.AreEqual( DebugInfo.DwarfEmissionKind.LineTablesOnly, compileUnit.EmissionKind );
+                Assert.AreEqual( "test.dwo", compileUnit.SplitDebugFileName );
+            }
+
+            using( var module = new NativeModule( TestModuleName ) )
+            {
+                var compileUnit = module.DIBuilder.CreateCompileUnit( DebugInfo.SourceLanguage.C, "test.c", "unit-test", false, string.Empty, 0 );
+                Assert.AreEqual( DebugInfo.DwarfEmissionKind.Full, compileUnit.EmissionKind );
+                Assert.AreEqual( string.Empty, compileUnit.SplitDebugFileName );
+            }
+        }
+
+        [TestMethod]
+        public void LineTablesOnlyEmitsNoTypesTest( )
+        {
+            using( var context = new Context( ) )
+            using( var targetMachine = TargetTests.GetTargetMachine( context ) )
+            {
+                // the name of the type is only in the object file if a DIE for the type is emitted
+                Assert.IsTrue( EmitsDebugTypeName( context, targetMachine, DwarfEmissionKind.Full ) );
+                Assert.IsFalse( EmitsDebugTypeName( context, targetMachine, DwarfEmissionKind.LineTablesOnly ) );
+            }
+        }
+
+        [TestMethod]
+        public void ParallelOptimizeMatchesSerialTest( )
+        {
+            using( var context = new Context( ) )
+            using( var targetMachine = TargetTests.GetTargetMachine( context ) )
+            using( var serialModule = CreateOptimizerTestModule( context, targetMachine ) )
+            using( var parallelModule = serialModule.Clone( ) )
+            {
+                serialModule.Optimize( targetMachine, new LegacyOptimizerOptions { Passes = "O2", DisableUnitAtATime = true } );
+                parallelModule.Optimize( targetMachine, new LegacyOptimizerOptions { Passes = "O2", DisableUnitAtATime = true, WorkerCount = 2 } );
+
+                Assert.IsTrue( parallelModule.Verify( out string errMsg ), errMsg );
+                string parallelText = parallelModule.WriteToString( );
+                Assert.AreEqual( serialModule.WriteToString( ), parallelText );
+
+                Assert.AreEqual( 1, Regex.Matches( parallelText, @"!DICompileUnit\(" ).Count );
+                Assert.IsNotNull( parallelModule.GetFunction( "inline_value" ).Comdat );
+                Assert.IsFalse( parallelText.Contains( "llvmnet.anon" ) );
+            }
+        }
+
+        [TestMethod]
+        public void ParallelPassPipelineMatchesSerialTest( )
+        {
+            using( var context = new Context( ) )
+            using( var targetMachine = TargetTests.GetTargetMachine( context ) )
+            using( var serialModule = CreateOptimizerTestModule( context, targetMachine ) )
+            using( var parallelModule = serialModule.Clone( ) )
+            {
+                serialModule.Optimize( targetMachine, "globalopt", "instcombine,simplifycfg", 1 );
+                parallelModule.Optimize( targetMachine, "globalopt", "instcombine,simplifycfg", 2 );
+
+                Assert.IsTrue( parallelModule.Verify( out string errMsg ), errMsg );
+                string parallelText = parallelModule.WriteToString( );
+                Assert.AreEqual( serialModule.WriteToString( ), parallelText );
+
+                // instcombine removes the add of 0 in inline_value
+                Assert.IsFalse( parallelText.Contains( "add i32" ) );
+                Assert.IsNotNull( parallelModule.GetFunction( "inline_value" ).Comdat );
+            }
+        }
+
+        [TestMethod]
+        [ExpectedArgumentException( null )]
+        public void ParallelPassPipelineRejectsModulePassesTest( )
+        {
+            using( var context = new Context( ) )
+            using( var targetMachine = TargetTests.GetTargetMachine( context ) )
+            using( var module = CreateOptimizerTestModule( context, targetMachine ) )
+            {
+                module.Optimize( targetMachine, null, "globalopt", 2 );
+            }
+        }
+
         private NativeModule CreateSimpleModule( string name, Context ctx = null )
         {
             var retVal = new NativeModule( name, ctx );
@@ -464,6 +766,66 @@ private NativeModule CreateSimpleModule( string name, Context ctx = null )
             return retVal;
         }
 
+        private static NativeModule CreateOptimizerTestModule( Context context, TargetMachine targetMachine )
+        {
+            var module = new NativeModule( TestModuleName, context, SourceLanguage.C, "test.c", "unit-test" )
+            {
+                Layout = targetMachine.TargetData,
+                TargetTriple = targetMachine.Triple
+            };
+
+            module.AddModuleFlag( ModuleFlagBehavior.Warning, NativeModule.DebugVersionValue, NativeModule.DebugMetadataVersion );
+            var diFile = module.DIBuilder.CreateFile( "test.c" );
+            var i32 = new DebugBasicType( context.Int32Type, module, "int", DiTypeKind.Signed );
+
+            var table = module.AddGlobal( context.Int32Type, true, Linkage.Internal, context.CreateConstant( 42 ), "table" );
+            var anonymous = module.AddGlobal( context.Int32Type, false, Linkage.Internal, context.CreateConstant( 1 ) );
+
+            var getValue = module.CreateFunction( module.DICompileUnit, "get_value", null, diFile, 1, context.CreateFunctionType( module.DIBuilder, i32 ), false, true, 1, DebugInfoFlags.None, true );
+            var builder = new InstructionBuilder( getValue.AppendBasicBlock( "entry" ) );
+            var value = builder.Load( table ).SetDebugLocation( 2, 12, getValue.DISubProgram );
+            builder.Return( value ).SetDebugLocation( 2, 5, getValue.DISubProgram );
+
+            var inlineValue = module.CreateFunction( module.DICompileUnit, "inline_value", null, diFile, 5, context.CreateFunctionType( module.DIBuilder, i32, i32 ), false, true, 5, DebugInfoFlags.None, true );
+            inlineValue.Linkage = Linkage.WeakODR;
+            inlineValue.Comdat( "inline_value" );
+            builder = new InstructionBuilder( inlineValue.AppendBasicBlock( "entry" ) );
+            var sum = builder.Add( inlineValue.Parameters[ 0 ], context.CreateConstant( 0 ) ).SetDebugLocation( 6, 14, inlineValue.DISubProgram );
+            builder.Return( sum ).SetDebugLocation( 6, 5, inlineValue.DISubProgram );
+
+            var getAnonymous = module.AddFunction( "get_anonymous", context.GetFunctionType( context.Int32Type ) );
+            builder = new InstructionBuilder( getAnonymous.AppendBasicBlock( "entry" ) );
+            builder.Return( builder.Load( anonymous ) );
+
+            module.DIBuilder.Finish( );
+            Assert.IsTrue( module.Verify( out string errMsg ), errMsg );
+            return module;
+        }
+
+        private static bool EmitsDebugTypeName( Context context, TargetMachine targetMachine, DwarfEmissionKind emissionKind )
+        {
+            const string typeName = "llvmnet_test_int";
+            using( var module = new NativeModule( TestModuleName, context ) )
+            {
+                module.Layout = targetMachine.TargetData;
+                module.TargetTriple = targetMachine.Triple;
+                module.AddModuleFlag( ModuleFlagBehavior.Warning, NativeModule.DebugVersionValue, NativeModule.DebugMetadataVersion );
+                module.DIBuilder.CreateCompileUnit( SourceLanguage.C, "test.c", "unit-test", "Llvm.NETTests", false, string.Empty, 0, emissionKind, null );
+                var diFile = module.DIBuilder.CreateFile( "test.c" );
+                var i32 = new DebugBasicType( context.Int32Type, module, typeName, DiTypeKind.Signed );
+
+                var getValue = module.CreateFunction( module.DICompileUnit, "get_value", null, diFile, 1, context.CreateFunctionType( module.DIBuilder, i32 ), false, true, 1, DebugInfoFlags.None, false );
+                var builder = new InstructionBuilder( getValue.AppendBasicBlock( "entry" ) );
+                builder.Return( context.CreateConstant( 42 ) ).SetDebugLocation( 2, 5, getValue.DISubProgram );
+                module.DIBuilder.Finish( );
+
+                using( var objectFile = targetMachine.EmitToBuffer( module, CodeGenFileType.ObjectFile ) )
+                {
+                    return Encoding.ASCII.GetString( objectFile.ToArray( ) ).Contains( typeName );
+                }
+            }
+        }
+
         private static Function CreateSimpleVoidNopTestFunction( NativeModule module, string name )
         {
             var ctx = module.Context;
@@ -0,0 +1,98 @@
+﻿using System;
+using System.IO;
+using System.Linq;
+using Llvm.NET.Values.Tests;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+namespace Llvm.NET.Tests
+{
+    [TestClass]
+    public class ObjectCacheTests
+    {
+        [TestInitialize]
+        public void CreateCacheDirectory( )
+        {
+            CacheDirectory = Path.Combine( Path.GetTempPath( ), Path.GetRandomFileName( ) );
+        }
+
+        [TestCleanup]
+        public void DeleteCacheDirectory( )
+        {
+            if( Directory.Exists( CacheDirectory ) )
+            {
+                Directory.Delete( CacheDirectory, true );
+            }
+        }
+
+        [TestMethod]
+        public void MissThenHitTest( )
+        {
+            using( var context = new Context( ) )
+            using( var targetMachine = TargetTests.GetTargetMachine( context ) )
+            using( var module = new NativeModule( "test", context ) )
+            using( var cache = new ObjectCache( CacheDirectory, 0 ) )
+            {
+                FunctionTests.CreateTestFunction( module, "first" );
+
+                using( var compiled = cache.CompileModule( module, targetMachine, null ) )
+                using( var cached = cache.CompileModule( module, targetMachine, null ) )
+                {
+                    Assert.AreEqual( 1L, cache.MissCount );
+                    Assert.AreEqual( 1L, cache.HitCount );
+                    Assert.AreEqual( ( long )compiled.Size, cache.SizeInBytes );
+                    Assert.IsTrue( compiled.ToArray( ).SequenceEqual( cached.ToArray( ) ) );
+                }
+            }
+        }
+
+        [TestMethod]
+        public void PipelineIsPartOfKeyTest( )
+        {
+            using( var context = new Context( ) )
+            using( var targetMachine = TargetTests.GetTargetMachine( context ) )
+            using( var module = new NativeModule( "test", context ) )
+            using( var cache = new ObjectCache( CacheDirectory, 0 ) )
+            {
+                FunctionTests.CreateTestFunction( module, "first" );
+
+                // compiling without a pipeline doesn't modify the module, so only the pipeline differs
+                cache.CompileModule( module, targetMachine, null ).Dispose( );
+                cache.CompileModule( module, targetMachine, "mem2reg" ).Dispose( );
+                Assert.AreEqual( 2L, cache.MissCount );
+                Assert.AreEqual( 0L, cache.HitCount );
+            }
+        }
+
+        [TestMethod]
+        public void LeastRecentlyUsedIsEvictedTest( )
+        {
+            using( var context = new Context( ) )
+            using( var targetMachine = TargetTests.GetTargetMachine( context ) )
+            using( var first = new NativeModule( "first", context ) )
+            using( var second = new NativeModule( "second", context ) )
+            using( var cache = new ObjectCache( CacheDirectory, 1 ) )
+            {
+                FunctionTests.CreateTestFunction( first, "first" );
+                FunctionTests.CreateTestFunction( second, "second" );
+
+                // the entry just stored is never evicted, even though it exceeds the maximum size
+                cache.CompileModule( first, targetMachine, null ).Dispose( );
+                Assert.AreEqual( 0L, cache.EvictionCount );
+
+                using( var compiled = cache.CompileModule( second, targetMachine, null ) )
+                {
+                    Assert.AreEqual( 1L, cache.EvictionCount );
+                    Assert.AreEqual( ( long )compiled.Size, cache.SizeInBytes );
+                }
+
+                // second evicted first, so it is compiled again
+                cache.CompileModule( first, targetMachine, null ).Dispose( );
+                Assert.AreEqual( 3L, cache.MissCount );
+                Assert.AreEqual( 0L, cache.HitCount );
+                Assert.AreEqual( 2L, cache.EvictionCount );
+            }
+        }
+
+        private string CacheDirectory;
+    }
+}
@@ -0,0 +1,85 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using Llvm.NET.Instructions;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+namespace Llvm.NET.Tests
+{
+    [TestClass]
+    public class OrcJitTests
+    {
+        [TestMethod]
+        public void EagerlyCompiledModuleTest( )
+        {
+            // the JIT must be disposed before the context of the modules in it
+            using( var context = new Context( ) )
+            using( var jit = new OrcJit( ) )
+            {
+                int handle = jit.AddEagerlyCompiledModule( CreateAddModule( context ) );
+                Assert.AreNotEqual( IntPtr.Zero, jit.GetSymbolAddress( AddFunctionName ) );
+                Assert.AreEqual( 5, CallAdd( jit, 2, 3 ) );
+
+                jit.RemoveModule( handle );
+                Assert.AreEqual( IntPtr.Zero, jit.GetSymbolAddress( AddFunctionName ) );
+            }
+        }
+
+        [TestMethod]
+        public void LazilyCompiledModuleTest( )
+        {
+            using( var context = new Context( ) )
+            using( var jit = new OrcJit( ) )
+            {
+                jit.AddLazilyCompiledModule( CreateAddModule( context ) );
+
+                // the first call goes through the stub that compiles the function
+                Assert.AreEqual( 5, CallAdd( jit, 2, 3 ) );
+                Assert.AreEqual( -1, CallAdd( jit, 1, -2 ) );
+            }
+        }
+
+        [TestMethod]
+        public void AddedModuleIsDetachedTest( )
+        {
+            using( var context = new Context( ) )
+            using( var jit = new OrcJit( ) )
+            {
+                var module = CreateAddModule( context );
+                jit.AddEagerlyCompiledModule( module );
+                Assert.IsTrue( module.IsDisposed );
+            }
+        }
+
+        [TestMethod]
+        public void UndefinedSymbolTest( )
+        {
+            using( var jit = new OrcJit( ) )
+            {
+                Assert.AreEqual( IntPtr.Zero, jit.GetSymbolAddress( "llvmnet_undefined_symbol" ) );
+            }
+        }
+
+        [UnmanagedFunctionPointer( CallingConvention.Cdecl )]
+        private delegate int AddFunction( int a, int b );
+
+        private static int CallAdd( OrcJit jit, int a, int b )
+        {
+            var address = jit.GetSymbolAddress( AddFunctionName );
+            Assert.AreNotEqual( IntPtr.Zero, address );
+            var add = Marshal.GetDelegateForFunctionPointer<AddFunction>( address );
+            return add( a, b );
+        }
+
+        private static NativeModule CreateAddModule( Context context )
+        {
+            var module = new NativeModule( "jit", context );
+            var add = module.AddFunction( AddFunctionName, context.GetFunctionType( context.Int32Type, context.Int32Type, context.Int32Type ) );
+            var builder = new InstructionBuilder( add.AppendBasicBlock( "entry" ) );
+            builder.Return( builder.Add( add.Parameters[ 0 ], add.Parameters[ 1 ] ) );
+            Assert.IsTrue( module.Verify( out string errMsg ), errMsg );
+            return module;
+        }
+
+        private const string AddFunctionName = "add";
+    }
+}
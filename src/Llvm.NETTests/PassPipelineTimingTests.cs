@@ -0,0 +1,85 @@
+﻿using System;
+using System.Collections.Generic;
+using Llvm.NET.Instructions;
+using Llvm.NETTests;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+namespace Llvm.NET.Tests
+{
+    [TestClass]
+    public class PassPipelineTimingTests
+    {
+        [TestMethod]
+        public void AliasIsOneStageTest( )
+        {
+            var timings = RunWithTiming( "default<O2>", false );
+            Assert.AreEqual( 1, timings.Count );
+            Assert.AreEqual( "default<O2>", timings[ 0 ].PassName );
+        }
+
+        [TestMethod]
+        public void FunctionGroupIsOneStageTest( )
+        {
+            var timings = RunWithTiming( "function(instcombine,simplifycfg)", false );
+            Assert.AreEqual( 1, timings.Count );
+            Assert.AreEqual( "function(instcombine,simplifycfg)", timings[ 0 ].PassName );
+
+            // instcombine removes the add of 0
+            Assert.AreEqual( 3L, timings[ 0 ].InstructionCountBefore );
+            Assert.AreEqual( 2L, timings[ 0 ].InstructionCountAfter );
+        }
+
+        [TestMethod]
+        public void FunctionPipelineIsOneStageTest( )
+        {
+            // the parser runs a pipeline that starts with a function pass in a single adaptor
+            var timings = RunWithTiming( "instcombine,simplifycfg", false );
+            Assert.AreEqual( 1, timings.Count );
+            Assert.AreEqual( "instcombine,simplifycfg", timings[ 0 ].PassName );
+        }
+
+        [TestMethod]
+        public void ModulePipelineStagesTest( )
+        {
+            var timings = RunWithTiming( "globaldce, function(instcombine),globaldce", true );
+            Assert.AreEqual( 5, timings.Count );
+            Assert.AreEqual( "verify", timings[ 0 ].PassName );
+            Assert.AreEqual( "globaldce", timings[ 1 ].PassName );
+            Assert.AreEqual( "function(instcombine)", timings[ 2 ].PassName );
+            Assert.AreEqual( "globaldce", timings[ 3 ].PassName );
+            Assert.AreEqual( "verify", timings[ 4 ].PassName );
+
+            // each stage starts with the instructions left by the previous one
+            for( int i = 1; i < timings.Count; ++i )
+            {
+                Assert.AreEqual( timings[ i - 1 ].InstructionCountAfter, timings[ i ].InstructionCountBefore );
+            }
+        }
+
+        [TestMethod]
+        [ExpectedArgumentException( "passPipeline" )]
+        public void ModulePassFollowedByFunctionPassIsRejectedTest( )
+        {
+            // a pipeline starting with a module pass only accepts module passes, as with Optimize
+            RunWithTiming( "globaldce,instcombine", false );
+        }
+
+        private static IReadOnlyList<PassStageTiming> RunWithTiming( string passPipeline, bool verify )
+        {
+            using( var context = new Context( ) )
+            using( var targetMachine = TargetTests.GetTargetMachine( context ) )
+            using( var module = new NativeModule( "test", context ) )
+            {
+                // %sum = add i32 %a, 0
+                // %result = add i32 %sum, %b
+                // ret i32 %result
+                var function = module.AddFunction( "add", context.GetFunctionType( context.Int32Type, context.Int32Type, context.Int32Type ) );
+                var builder = new InstructionBuilder( function.AppendBasicBlock( "entry" ) );
+                var sum = builder.Add( function.Parameters[ 0 ], context.CreateConstant( 0 ) );
+                builder.Return( builder.Add( sum, function.Parameters[ 1 ] ) );
+
+                return module.OptimizeWithTiming( targetMachine, passPipeline, verify );
+            }
+        }
+    }
+}
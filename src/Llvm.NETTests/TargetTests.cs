@@ -1,4 +1,5 @@
 ﻿using System.Collections.ObjectModel;
+using Llvm.NET.Instructions;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 
 namespace Llvm.NET.Tests
@@ -55,6 +56,70 @@ public void AvailableTargetsTest()
             Assert.AreEqual( TargetInfo.ExpectedTargets.Count, foundTargets );
         }
 
+        [TestMethod]
+        public void EmitPartitionsToBuffersTest( )
+        {
+            using( var context = new Context( ) )
+            using( var module = new NativeModule( "test", context ) )
+            using( var machine = GetTargetMachine( context ) )
+            {
+                module.TargetTriple = machine.Triple;
+                for( int i = 0; i < 4; ++i )
+                {
+                    var func = module.AddFunction( $"func{i}", context.GetFunctionType( context.VoidType ) );
+                    func.AppendBasicBlock( "entry" );
+                    new InstructionBuilder( func.EntryBlock ).Return( );
+                }
+
+                var buffers = machine.EmitPartitionsToBuffers( module, 2, CodeGenFileType.ObjectFile );
+                Assert.AreEqual( 2, buffers.Count );
+                foreach( var buffer in buffers )
+                {
+                    Assert.IsTrue( buffer.Size > 0 );
+                    buffer.Dispose( );
+                }
+
+                // source module is not consumed by the split
+                Assert.AreEqual( 4, System.Linq.Enumerable.Count( module.Functions ) );
+            }
+        }
+
+        [TestMethod]
+        public void ThinLtoCodeGeneratorTest( )
+        {
+            using( var context = new Context( ) )
+            using( var callee = new NativeModule( "callee", context ) )
+            using( var caller = new NativeModule( "caller", context ) )
+            using( var machine = GetTargetMachine( context ) )
+            using( var codeGen = new ThinLtoCodeGenerator( machine, 2 ) )
+            {
+                var funcType = context.GetFunctionType( context.VoidType );
+                callee.TargetTriple = machine.Triple;
+                var calleeFunc = callee.AddFunction( "callee", funcType );
+                calleeFunc.AppendBasicBlock( "entry" );
+                new InstructionBuilder( calleeFunc.EntryBlock ).Return( );
+
+                caller.TargetTriple = machine.Triple;
+                var callerFunc = caller.AddFunction( "caller", funcType );
+                callerFunc.AppendBasicBlock( "entry" );
+                var builder = new InstructionBuilder( callerFunc.EntryBlock );
+                builder.Call( caller.AddFunction( "callee", funcType ) );
+                builder.Return( );
+
+                codeGen.AddModule( callee );
+                codeGen.AddModule( caller );
+                codeGen.PreserveSymbol( "caller" );
+
+                var objects = codeGen.Run( );
+                Assert.AreEqual( 2, objects.Count );
+                foreach( var obj in objects )
+                {
+                    Assert.IsTrue( obj.Size > 0 );
+                    obj.Dispose( );
+                }
+            }
+        }
+
         internal static TargetMachine GetTargetMachine( Context context )
         {
             var target = Target.FromTriple( DefaultTargetTriple );
@@ -29,6 +29,26 @@ public void ToStringTest( )
             Assert.AreEqual( "thumbv7m-none--eabi", str );
         }
 
+        [TestMethod]
+        public void ComponentNamesTest( )
+        {
+            var triple = new Triple( "x86_64-pc-windows-msvc" );
+            Assert.AreEqual( "x86_64", Triple.GetCanonicalName( triple.ArchitectureType ) );
+            Assert.AreEqual( "pc", Triple.GetCanonicalName( triple.VendorType ) );
+            Assert.AreEqual( "windows", Triple.GetCanonicalName( triple.OSType ) );
+            Assert.AreEqual( "msvc", Triple.GetCanonicalName( triple.EnvironmentType ) );
+            Assert.AreEqual( "coff", Triple.GetCanonicalName( triple.ObjectFormatType ) );
+
+            // there is no sub architecture, which has an empty name rather than null
+            Assert.AreEqual( TripleSubArchType.NoSubArch, triple.SubArchitecture );
+            Assert.AreEqual( string.Empty, Triple.GetCanonicalName( triple.SubArchitecture ) );
+
+            // the normalized text round trips through a new triple
+            Assert.AreEqual( "x86_64-pc-windows-msvc", triple.ToString( ) );
+            Assert.AreEqual( triple.ToString( ), Triple.Normalize( triple.ToString( ) ) );
+            Assert.AreEqual( triple, new Triple( triple.ToString( ) ) );
+        }
+
         [TestMethod]
         public void OpEqualsTest( )
         {
@@ -88,6 +88,29 @@ public void ImplicitCastStringToAttributeValueTest( )
             }
         }
 
+        [TestMethod]
+        public void ToStringTest( )
+        {
+            using( var ctx = new Context( ) )
+            {
+                var enumValue = ctx.CreateAttribute( AttributeKind.AlwaysInline );
+                var intValue = ctx.CreateAttribute( AttributeKind.DereferenceableOrNull, 1234ul );
+                var stringValue = ctx.CreateAttribute( TestTargetDependentAttributeName );
+                var stringWithValue = ctx.CreateAttribute( TestTargetDependentAttributeName, "value" );
+
+                Assert.AreEqual( "alwaysinline", enumValue.ToString( ) );
+                Assert.AreEqual( "dereferenceable_or_null(1234)", intValue.ToString( ) );
+                Assert.AreEqual( "\"TestCustom\"", stringValue.ToString( ) );
+                Assert.AreEqual( "\"TestCustom\"=\"value\"", stringWithValue.ToString( ) );
+
+                // the native text is reused for each call, so earlier results must not change
+                string first = enumValue.ToString( );
+                string second = stringWithValue.ToString( );
+                Assert.AreEqual( "alwaysinline", first );
+                Assert.AreEqual( "\"TestCustom\"=\"value\"", second );
+            }
+        }
+
         // test all int value parameters to ensure that a value is provided (implicit casting from enum should provide default value of 0)
     }
 }
\ No newline at end of file
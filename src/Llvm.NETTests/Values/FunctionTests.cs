@@ -0,0 +1,89 @@
+﻿using System.Linq;
+using Llvm.NET.Instructions;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+namespace Llvm.NET.Values.Tests
+{
+    [TestClass]
+    public class FunctionTests
+    {
+        [TestMethod]
+        public void InstructionsTest( )
+        {
+            using( var context = new Context( ) )
+            using( var module = new NativeModule( "test", context ) )
+            {
+                var function = CreateTestFunction( module, "test" );
+                AssertInstructionsInBlockOrder( function );
+            }
+        }
+
+        [TestMethod]
+        public void InstructionsWrappersTest( )
+        {
+            using( var context = new Context( ) )
+            using( var module = new NativeModule( "test", context ) )
+            {
+                CreateTestFunction( module, "test" );
+
+                // none of the instructions of the clone have a managed wrapper yet, so they are
+                // all created from the value kinds of the bulk enumeration
+                using( var clone = module.Clone( ) )
+                {
+                    var instructions = clone.GetFunction( "test" ).Instructions;
+                    Assert.AreEqual( 5, instructions.Count );
+                    Assert.IsInstanceOfType( instructions[ 0 ], typeof( Alloca ) );
+                    Assert.IsInstanceOfType( instructions[ 1 ], typeof( Store ) );
+                    Assert.IsInstanceOfType( instructions[ 2 ], typeof( Branch ) );
+                    Assert.IsInstanceOfType( instructions[ 3 ], typeof( Load ) );
+                    Assert.IsInstanceOfType( instructions[ 4 ], typeof( ReturnInstruction ) );
+                    foreach( var instruction in instructions )
+                    {
+                        Assert.AreSame( context, instruction.Context );
+                    }
+
+                    AssertInstructionsInBlockOrder( clone.GetFunction( "test" ) );
+                }
+            }
+        }
+
+        [TestMethod]
+        public void DeclarationInstructionsTest( )
+        {
+            using( var context = new Context( ) )
+            using( var module = new NativeModule( "test", context ) )
+            {
+                var function = module.AddFunction( "external", context.GetFunctionType( context.VoidType ) );
+                Assert.AreEqual( 0, function.Instructions.Count );
+            }
+        }
+
+        internal static Function CreateTestFunction( NativeModule module, string name )
+        {
+            var context = module.Context;
+            var function = module.AddFunction( name, context.GetFunctionType( context.Int32Type, context.Int32Type ) );
+            var entry = function.AppendBasicBlock( "entry" );
+            var exit = function.AppendBasicBlock( "exit" );
+
+            var builder = new InstructionBuilder( entry );
+            var local = builder.Alloca( context.Int32Type );
+            builder.Store( function.Parameters[ 0 ], local );
+            builder.Branch( exit );
+
+            builder = new InstructionBuilder( exit );
+            builder.Return( builder.Load( local ) );
+            return function;
+        }
+
+        private static void AssertInstructionsInBlockOrder( Function function )
+        {
+            var expected = function.BasicBlocks.SelectMany( b => b.Instructions ).ToList( );
+            var instructions = function.Instructions;
+            Assert.AreEqual( expected.Count, instructions.Count );
+            for( int i = 0; i < expected.Count; ++i )
+            {
+                Assert.AreSame( expected[ i ], instructions[ i ] );
+            }
+        }
+    }
+}
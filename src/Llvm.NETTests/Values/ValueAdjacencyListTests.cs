@@ -0,0 +1,113 @@
+﻿using System.Collections.Generic;
+using System.Linq;
+using Llvm.NET.Instructions;
+using Llvm.NETTests;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+
+namespace Llvm.NET.Values.Tests
+{
+    [TestClass]
+    public class ValueAdjacencyListTests
+    {
+        [TestMethod]
+        public void GetOperandsTest( )
+        {
+            using( var context = new Context( ) )
+            using( var module = new NativeModule( "test", context ) )
+            {
+                var function = FunctionTests.CreateTestFunction( module, "test" );
+                var instructions = function.Instructions;
+                var operands = ValueAdjacencyList.GetOperands( instructions );
+
+                // alloca (array size), store (value, pointer), br (target), load (pointer), ret (value)
+                Assert.AreEqual( instructions.Count, operands.Count );
+                Assert.AreEqual( 6, operands.EdgeCount );
+                Assert.AreEqual( 1, operands[ 0 ].Count );
+                Assert.AreEqual( 2, operands[ 1 ].Count );
+                Assert.AreSame( function.Parameters[ 0 ], operands[ 1 ][ 0 ] );
+                Assert.AreSame( instructions[ 0 ], operands[ 1 ][ 1 ] );
+                Assert.AreEqual( 1, operands[ 2 ].Count );
+                Assert.IsInstanceOfType( operands[ 2 ][ 0 ], typeof( BasicBlock ) );
+                Assert.AreEqual( 1, operands[ 3 ].Count );
+                Assert.AreSame( instructions[ 0 ], operands[ 3 ][ 0 ] );
+                Assert.AreEqual( 1, operands[ 4 ].Count );
+                Assert.AreSame( instructions[ 3 ], operands[ 4 ][ 0 ] );
+
+                // the entries are the same as the operands of each instruction
+                for( int i = 0; i < instructions.Count; ++i )
+                {
+                    var expected = instructions[ i ].Operands;
+                    Assert.AreEqual( expected.Count, operands[ i ].Count );
+                    for( int j = 0; j < expected.Count; ++j )
+                    {
+                        Assert.AreSame( expected[ j ], operands[ i ][ j ] );
+                    }
+                }
+            }
+        }
+
+        [TestMethod]
+        public void GetUsersTest( )
+        {
+            using( var context = new Context( ) )
+            using( var module = new NativeModule( "test", context ) )
+            {
+                var function = FunctionTests.CreateTestFunction( module, "test" );
+                var instructions = function.Instructions;
+                var users = ValueAdjacencyList.GetUsers( new Value[ ] { function.Parameters[ 0 ], instructions[ 0 ], instructions[ 4 ] } );
+
+                Assert.AreEqual( 3, users.Count );
+                Assert.AreEqual( 3, users.EdgeCount );
+                Assert.AreEqual( 1, users[ 0 ].Count );
+                Assert.AreSame( instructions[ 1 ], users[ 0 ][ 0 ] );
+                CollectionAssert.AreEquivalent( new[ ] { instructions[ 1 ], instructions[ 3 ] }, users[ 1 ].ToList( ) );
+                Assert.AreEqual( 0, users[ 2 ].Count );
+            }
+        }
+
+        [TestMethod]
+        public void GetUsersMoreThanInitialCapacityTest( )
+        {
+            using( var context = new Context( ) )
+            using( var module = new NativeModule( "test", context ) )
+            {
+                // a single value with many users needs more than the capacity of the first native call
+                var global = module.AddGlobal( context.Int32Type, false, Linkage.Internal, context.CreateConstant( 0 ), "global" );
+                var function = module.AddFunction( "test", context.GetFunctionType( context.VoidType ) );
+                var builder = new InstructionBuilder( function.AppendBasicBlock( "entry" ) );
+                var loads = new List<Value>( );
+                for( int i = 0; i < 32; ++i )
+                {
+                    loads.Add( builder.Load( global ) );
+                }
+
+                builder.Return( );
+
+                var users = ValueAdjacencyList.GetUsers( new Value[ ] { global, function } );
+                Assert.AreEqual( 2, users.Count );
+                Assert.AreEqual( loads.Count, users.EdgeCount );
+                CollectionAssert.AreEquivalent( loads, users[ 0 ].ToList( ) );
+                Assert.AreEqual( 0, users[ 1 ].Count );
+            }
+        }
+
+        [TestMethod]
+        public void EmptyValuesTest( )
+        {
+            var operands = ValueAdjacencyList.GetOperands( Enumerable.Empty<Value>( ) );
+            Assert.AreEqual( 0, operands.Count );
+            Assert.AreEqual( 0, operands.EdgeCount );
+        }
+
+        [TestMethod]
+        [ExpectedArgumentException( "values", ExpectedExceptionMessage = "Values must all belong to the same context" )]
+        public void ValuesFromDifferentContextsTest( )
+        {
+            using( var context = new Context( ) )
+            using( var otherContext = new Context( ) )
+            {
+                ValueAdjacencyList.GetUsers( new Value[ ] { context.CreateConstant( 1 ), otherContext.CreateConstant( 1 ) } );
+            }
+        }
+    }
+}